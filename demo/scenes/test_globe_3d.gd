@@ -41,6 +41,9 @@ func _process(_dt):
 	cp.forward = -(cam.global_transform.basis.z) # Godot: -Z est forward
 
 	var tiles : Array = qt.build_tile_list(cp)
+	# Géomorphing par sommet : le shader calcule morph depuis la distance caméra
+	mat.set_shader_parameter("camera_position", cp.position)
+	mat.set_shader_parameter("morph_distances", qt.get_morph_distances(cp))
 	mm.instance_count = tiles.size()
 	var max_lod := 0
 	for i in tiles.size():
@@ -54,4 +57,4 @@ func _process(_dt):
 		var tx = float(t.ix) * tile_size
 		var ty = float(t.iy) * tile_size
 		mm.set_instance_transform(i, Transform3D.IDENTITY)
-		mm.set_instance_custom_data(i, Color(tx, ty, tile_size, 0.0))
+		mm.set_instance_custom_data(i, Color(tx, ty, tile_size, t.finer_mask))
@@ -0,0 +1,75 @@
+extends SceneTree
+
+# Checks Ellipsoid against fixed reference pairs, in the geodetic_to_3d frame (polar axis on Y).
+# Rows: [lat, lon, h, x, y, z, surface_x, surface_y, surface_z], generated by gen_ellipsoid_reference.py.
+# Run: godot --headless --path demo -s res://tests/ellipsoid_reference_test.gd  (exit code 1 on failure)
+
+# WGS84 with b rounded to the nearest float, so that single-precision builds hold the exact axes
+const AXIS := Vector3(6378137.0, 6378137.0, 6356752.5)
+
+# Positions, altitudes and ground distances for lat / lon errors (meters)
+const TOLERANCE := 1e-4
+# scale_to_geodetic_surface works in real_t: float builds are limited by the Vector3 input itself
+const SURFACE_TOLERANCE_FLOAT := 2.0
+const SURFACE_TOLERANCE_DOUBLE := 1e-3
+
+const REFERENCE := [
+	[0, 0, 0, 0.000000000, 0.000000000, -6378137.000000000, 0.000000000, 0.000000000, -6378137.000000000],
+	[0, 90, 0, 6378137.000000000, 0.000000000, 0.000000000, 6378137.000000000, 0.000000000, 0.000000000],
+	[0, 180, 0, 0.000000000, 0.000000000, 6378137.000000000, 0.000000000, 0.000000000, 6378137.000000000],
+	[0, -90, 0, -6378137.000000000, 0.000000000, 0.000000000, -6378137.000000000, 0.000000000, 0.000000000],
+	[90, 0, 0, -0.000000000, 6356752.500000000, 0.000000000, -0.000000000, 6356752.500000000, 0.000000000],
+	[-90, 0, 0, -0.000000000, -6356752.500000000, 0.000000000, -0.000000000, -6356752.500000000, 0.000000000],
+	[45, 45, 0, 3194419.098544216, 4487348.605777730, -3194419.098544216, 3194419.098544216, 4487348.605777730, -3194419.098544216],
+	[48.8566, 2.3522, 35, 172560.718581270, 4780107.899630081, -4200937.734936948, 172559.773459392, 4780081.542346952, -4200914.726234883],
+	[-33.8688, 151.2093, 58, 2553229.512752534, -3534404.885542831, 4646093.435317929, 2553206.319154750, -3534372.562545980, 4646051.230094361],
+	[27.988056, 86.925278, 8848.86, 5636029.946576956, 2979489.334006189, -302742.709154785, 5628227.249805319, 2975336.674694560, -302323.582645211],
+	[-89.999, -179.999, 2835, -0.001950291, -6359587.499024854, 111.743456357, -0.001949428, -6356752.499025286, 111.693976272],
+	[89.9999, 179.9999, -10, 0.000019494, 6356742.499990253, 11.169380176, 0.000019494, 6356752.499990253, 11.169397630],
+	[0.000001, -179.999999, 100, -0.111321236, 0.110576028, 6378236.999999998, -0.111319491, 0.110574282, 6378136.999999998],
+	[-45.5, -120.25, -10000, -3862310.498964199, -4519336.898807704, 2252432.909883112, -3868365.202048488, -4526469.403299245, 2255963.908359356],
+	[60.1, 24.9, 400000, 1425983.500717194, 5852798.268532156, -3072018.478568189, 1342031.024332804, 5506039.568957915, -2891158.350351632],
+	[12.34567891, -67.891011, 35786000, -38161340.861156322, 9006161.400016217, -15502688.291866651, -5773386.897479732, 1354783.024344080, -2345384.502751546],
+	[-12.5, 179.5, 1000000, 62867.901792635, -1587894.799242101, 7203948.002880104, 54348.220029583, -1371455.185303998, 6227689.170120584],
+]
+
+var failures := 0
+
+
+func _init() -> void:
+	var e := Ellipsoid.new()
+	e.set_axis(AXIS)
+
+	# 2^24 + 1 only survives in a double-precision Vector3
+	var double_build := Vector3(16777217.0, 0.0, 0.0).x == 16777217.0
+	var surface_tolerance := SURFACE_TOLERANCE_DOUBLE if double_build else SURFACE_TOLERANCE_FLOAT
+
+	for row in REFERENCE:
+		var lat: float = row[0]
+		var lon: float = row[1]
+		var h: float = row[2]
+		var label := "(%s, %s, %s)" % [lat, lon, h]
+
+		var xyz: PackedFloat64Array = e.geodetic_to_3d_f64(lat, lon, h)
+		for i in 3:
+			_check(label + " geodetic_to_3d_f64[%d]" % i, xyz[i], row[3 + i], TOLERANCE)
+
+		var lla: PackedFloat64Array = e.cartesian_to_geodetic_f64(row[3], row[4], row[5])
+		_check(label + " latitude", deg_to_rad(lla[0] - lat) * AXIS.x, 0.0, TOLERANCE)
+		# Longitude is undefined on the polar axis: compare the ground distance along the parallel
+		var rho := Vector2(row[3], row[5]).length()
+		_check(label + " longitude", deg_to_rad(wrapf(lla[1] - lon, -180.0, 180.0)) * rho, 0.0, TOLERANCE)
+		_check(label + " altitude", lla[2], h, TOLERANCE)
+
+		var foot: Vector3 = e.scale_to_geodetic_surface(Vector3(row[3], row[4], row[5]))
+		_check(label + " scale_to_geodetic_surface", foot.distance_to(Vector3(row[6], row[7], row[8])), 0.0, surface_tolerance)
+
+	e.free()
+	print("ellipsoid_reference_test: %d rows, %d failure(s)" % [REFERENCE.size(), failures])
+	quit(1 if failures > 0 else 0)
+
+
+func _check(what: String, value: float, expected: float, tolerance: float) -> void:
+	if absf(value - expected) > tolerance:
+		failures += 1
+		printerr("%s: got %.9f, expected %.9f (tolerance %s)" % [what, value, expected, tolerance])
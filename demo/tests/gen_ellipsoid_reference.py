@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Reference (lat, lon, h) <-> (x, y, z) pairs for ellipsoid_reference_test.gd.
+
+Each row is [lat, lon, h, x, y, z, surface_x, surface_y, surface_z], the last
+three being the same point with h = 0.
+
+The geodetic -> ECEF formula is closed-form, so it is evaluated here with 40
+significant digits (Python's decimal module, no third-party dependency) and the
+result is exact to far below the test tolerances. The ECEF coordinates are then
+mapped to the frame used by Ellipsoid.geodetic_to_3d (polar axis on Godot Y):
+
+    x = Y_ecef,  y = Z_ecef,  z = -X_ecef
+
+The ellipsoid is WGS84 with b rounded to the nearest float (6356752.5 m), since
+Ellipsoid stores its axes in a Vector3 and single-precision builds could not
+represent the exact WGS84 value.
+
+Cross-check with PROJ (ECEF columns, before the axis swap above):
+    echo "<lon> <lat> <h>" | cs2cs -f %.9f +proj=longlat +a=6378137 +b=6356752.5 +to +proj=geocent +a=6378137 +b=6356752.5
+
+Usage: python3 gen_ellipsoid_reference.py > reference.txt, then paste the
+output into REFERENCE in ellipsoid_reference_test.gd.
+"""
+
+from decimal import Decimal, getcontext
+
+getcontext().prec = 40
+
+A = Decimal(6378137)
+B = Decimal("6356752.5")
+E2 = 1 - (B * B) / (A * A)
+
+# (lat_deg, lon_deg, h_m): poles, equator, antimeridian, high and low altitudes
+POINTS = [
+    ("0", "0", "0"),
+    ("0", "90", "0"),
+    ("0", "180", "0"),
+    ("0", "-90", "0"),
+    ("90", "0", "0"),
+    ("-90", "0", "0"),
+    ("45", "45", "0"),
+    ("48.8566", "2.3522", "35"),
+    ("-33.8688", "151.2093", "58"),
+    ("27.988056", "86.925278", "8848.86"),
+    ("-89.999", "-179.999", "2835"),
+    ("89.9999", "179.9999", "-10"),
+    ("0.000001", "-179.999999", "100"),
+    ("-45.5", "-120.25", "-10000"),
+    ("60.1", "24.9", "400000"),
+    ("12.34567891", "-67.891011", "35786000"),
+    ("-12.5", "179.5", "1000000"),
+]
+
+
+def pi():
+    # Machin's formula
+    def arctan_inv(x):
+        x = Decimal(x)
+        total, term, n, sign = Decimal(0), 1 / x, 1, 1
+        x2 = x * x
+        while term != 0:
+            total += sign * term / n
+            term /= x2
+            n += 2
+            sign = -sign
+        return total
+    return 16 * arctan_inv(5) - 4 * arctan_inv(239)
+
+
+PI = pi()
+
+
+def sin_cos(deg):
+    r = deg * PI / 180
+    s, c = Decimal(0), Decimal(0)
+    term, n = Decimal(1), 0
+    while True:
+        # term = r^n / n!
+        if n % 4 == 0:
+            c += term
+        elif n % 4 == 1:
+            s += term
+        elif n % 4 == 2:
+            c -= term
+        else:
+            s -= term
+        n += 1
+        term = term * r / n
+        if abs(term) < Decimal("1e-45"):
+            return s, c
+
+
+def main():
+    for lat_s, lon_s, h_s in POINTS:
+        lat, lon, h = Decimal(lat_s), Decimal(lon_s), Decimal(h_s)
+        sl, cl = sin_cos(lat)
+        so, co = sin_cos(lon)
+        n = A / (1 - E2 * sl * sl).sqrt()
+        x_ecef = (n + h) * cl * co
+        y_ecef = (n + h) * cl * so
+        z_ecef = (n * (1 - E2) + h) * sl
+        x, y, z = y_ecef, z_ecef, -x_ecef
+        # Foot point on the surface (h = 0): expected result of scale_to_geodetic_surface
+        sx, sy, sz = n * cl * so, n * (1 - E2) * sl, -n * cl * co
+        print("\t[%s, %s, %s, %.9f, %.9f, %.9f, %.9f, %.9f, %.9f]," % (lat_s, lon_s, h_s, x, y, z, sx, sy, sz))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,208 @@
+#include "line_simplifier.hpp"
+#include "vector_geometry_buffer.hpp"
+#include "math/ParallelFor.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+using namespace godot;
+
+namespace {
+
+constexpr int64_t IMPORTANCE_PART_GRAIN = 256;
+
+// Squared distance from p to the segment a-b (to a when the segment is degenerate, e.g. a ring)
+inline double segment_distance_squared(const double *p, const double *a, const double *b) {
+    const double dx = b[0] - a[0];
+    const double dy = b[1] - a[1];
+    double x = a[0];
+    double y = a[1];
+    const double len2 = dx * dx + dy * dy;
+    if (len2 > 0.0) {
+        const double t = ((p[0] - a[0]) * dx + (p[1] - a[1]) * dy) / len2;
+        if (t >= 1.0) {
+            x = b[0];
+            y = b[1];
+        } else if (t > 0.0) {
+            x += dx * t;
+            y += dy * t;
+        }
+    }
+    const double ex = p[0] - x;
+    const double ey = p[1] - y;
+    return ex * ex + ey * ey;
+}
+
+} // namespace
+
+void LineSimplifier::_bind_methods() {
+    ClassDB::bind_static_method("LineSimplifier", D_METHOD("compute_path_importance", "path"), &LineSimplifier::compute_path_importance);
+    ClassDB::bind_static_method("LineSimplifier", D_METHOD("simplify_path", "path", "importance", "tolerance"), &LineSimplifier::simplify_path);
+    ClassDB::bind_static_method("LineSimplifier", D_METHOD("compute_importance", "geometries"), &LineSimplifier::compute_importance);
+    ClassDB::bind_static_method("LineSimplifier", D_METHOD("simplify_geometries", "geometries", "importance", "tolerance"), &LineSimplifier::simplify_geometries);
+}
+
+void LineSimplifier::compute(const double *xy, int64_t count, float *importance) {
+    if (count <= 0) return;
+    const float inf = std::numeric_limits<float>::infinity();
+    importance[0] = inf;
+    importance[count - 1] = inf;
+    if (count < 3) return;
+
+    // Iterative DP: each range carries the importance of the split that created it
+    struct Range {
+        int64_t first, last;
+        double cap;
+    };
+    std::vector<Range> stack;
+    stack.push_back({ 0, count - 1, std::numeric_limits<double>::infinity() });
+    while (!stack.empty()) {
+        const Range r = stack.back();
+        stack.pop_back();
+        const double *a = xy + r.first * 2;
+        const double *b = xy + r.last * 2;
+        int64_t split = r.first + 1;
+        double max_d2 = -1.0;
+        for (int64_t i = r.first + 1; i < r.last; ++i) {
+            const double d2 = segment_distance_squared(xy + i * 2, a, b);
+            if (d2 > max_d2) {
+                max_d2 = d2;
+                split = i;
+            }
+        }
+        const double d = MIN(std::sqrt(max_d2), r.cap);
+        importance[split] = float(d);
+        if (split - r.first > 1) stack.push_back({ r.first, split, d });
+        if (r.last - split > 1) stack.push_back({ split, r.last, d });
+    }
+}
+
+int64_t LineSimplifier::select(const double *xy, const float *importance, int64_t count, double tolerance, double *out) {
+    int64_t kept = 0;
+    for (int64_t i = 0; i < count; ++i) {
+        if (importance[i] >= tolerance) {
+            out[kept * 2] = xy[i * 2];
+            out[kept * 2 + 1] = xy[i * 2 + 1];
+            ++kept;
+        }
+    }
+    return kept;
+}
+
+PackedFloat32Array LineSimplifier::compute_path_importance(const PackedVector2Array &path) {
+    PackedFloat32Array importance;
+    importance.resize(path.size());
+    std::vector<double> xy(size_t(path.size()) * 2);
+    for (int64_t i = 0; i < path.size(); ++i) {
+        xy[i * 2] = path[i].x;
+        xy[i * 2 + 1] = path[i].y;
+    }
+    compute(xy.data(), path.size(), importance.ptrw());
+    return importance;
+}
+
+PackedVector2Array LineSimplifier::simplify_path(const PackedVector2Array &path, const PackedFloat32Array &importance, double tolerance) {
+    ERR_FAIL_COND_V_MSG(importance.size() != path.size(), path, "One importance value per vertex expected");
+    const Vector2 *src = path.ptr();
+    const float *imp = importance.ptr();
+    int64_t kept = 0;
+    for (int64_t i = 0; i < path.size(); ++i) {
+        kept += imp[i] >= tolerance;
+    }
+    PackedVector2Array result;
+    result.resize(kept);
+    Vector2 *dst = result.ptrw();
+    for (int64_t i = 0; i < path.size(); ++i) {
+        if (imp[i] >= tolerance) {
+            *dst++ = src[i];
+        }
+    }
+    return result;
+}
+
+PackedFloat32Array LineSimplifier::compute_importance(const Dictionary &geometries) {
+    const PackedFloat64Array coords = geometries.get("coords", PackedFloat64Array());
+    const PackedInt32Array part_offsets = geometries.get("part_offsets", PackedInt32Array());
+    const PackedByteArray part_kinds = geometries.get("part_kinds", PackedByteArray());
+    PackedFloat32Array importance;
+    ERR_FAIL_COND_V_MSG(part_offsets.is_empty() || part_kinds.size() != part_offsets.size() - 1, importance,
+            "Expected the output of VectorSource.load_geometries");
+
+    importance.resize(coords.size() / 2);
+    const double *xy = coords.ptr();
+    const int32_t *parts = part_offsets.ptr();
+    const uint8_t *kinds = part_kinds.ptr();
+    float *imp = importance.ptrw();
+    parallel_for(part_kinds.size(), IMPORTANCE_PART_GRAIN, [&](int64_t begin, int64_t end) {
+        for (int64_t p = begin; p < end; ++p) {
+            const int64_t first = parts[p];
+            const int64_t count = parts[p + 1] - first;
+            if (kinds[p] == VectorGeometryBuffer::PART_POINTS) {
+                for (int64_t i = 0; i < count; ++i) {
+                    imp[first + i] = std::numeric_limits<float>::infinity();
+                }
+            } else {
+                compute(xy + first * 2, count, imp + first);
+            }
+        }
+    });
+    return importance;
+}
+
+Dictionary LineSimplifier::simplify_geometries(const Dictionary &geometries, const PackedFloat32Array &importance, double tolerance) {
+    const PackedFloat64Array coords = geometries.get("coords", PackedFloat64Array());
+    const PackedInt32Array part_offsets = geometries.get("part_offsets", PackedInt32Array());
+    const PackedByteArray part_kinds = geometries.get("part_kinds", PackedByteArray());
+    const PackedInt32Array feature_offsets = geometries.get("feature_offsets", PackedInt32Array());
+    ERR_FAIL_COND_V_MSG(feature_offsets.is_empty() || part_offsets.is_empty() || part_kinds.size() != part_offsets.size() - 1,
+            geometries, "Expected the output of VectorSource.load_geometries");
+    ERR_FAIL_COND_V_MSG(importance.size() != coords.size() / 2, geometries, "One importance value per vertex expected");
+
+    GrowablePacked<PackedFloat64Array, double> out_coords;
+    GrowablePacked<PackedInt32Array, int32_t> out_parts;
+    GrowablePacked<PackedByteArray, uint8_t> out_kinds;
+    GrowablePacked<PackedInt32Array, int32_t> out_features;
+    out_coords.reserve(coords.size());
+
+    const double *xy = coords.ptr();
+    const float *imp = importance.ptr();
+    const int32_t *parts = part_offsets.ptr();
+    const uint8_t *kinds = part_kinds.ptr();
+    const int32_t *features = feature_offsets.ptr();
+    const int64_t feature_count = feature_offsets.size() - 1;
+    for (int64_t f = 0; f < feature_count; ++f) {
+        out_features.push_back(int32_t(out_parts.size()));
+        bool exterior_kept = true;
+        for (int32_t p = features[f]; p < features[f + 1]; ++p) {
+            const uint8_t kind = kinds[p];
+            if (kind == VectorGeometryBuffer::PART_INTERIOR_RING && !exterior_kept) {
+                continue;
+            }
+            const int64_t first = parts[p];
+            const int64_t count = parts[p + 1] - first;
+            const int64_t base = out_coords.size();
+            double *dst = out_coords.grow(count * 2);
+            const int64_t kept = select(xy + first * 2, imp + first, count, tolerance, dst);
+            const bool ring = kind == VectorGeometryBuffer::PART_EXTERIOR_RING || kind == VectorGeometryBuffer::PART_INTERIOR_RING;
+            const bool valid = ring ? kept >= 4 : kept > 0;
+            if (kind == VectorGeometryBuffer::PART_EXTERIOR_RING) {
+                exterior_kept = valid;
+            }
+            // Give back the unused slots (all of them when the part is dropped)
+            out_coords.truncate(base + (valid ? kept * 2 : 0));
+            if (valid) {
+                out_parts.push_back(int32_t(base / 2));
+                out_kinds.push_back(kind);
+            }
+        }
+    }
+    out_features.push_back(int32_t(out_parts.size()));
+    out_parts.push_back(int32_t(out_coords.size() / 2));
+
+    Dictionary result = geometries.duplicate();
+    result["coords"] = out_coords.finish();
+    result["part_offsets"] = out_parts.finish();
+    result["part_kinds"] = out_kinds.finish();
+    result["feature_offsets"] = out_features.finish();
+    return result;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+
+#include <cstdint>
+
+// Douglas–Peucker importance per vertex, computed once: the largest tolerance at which the
+// vertex survives DP simplification (its distance to the chord it was split from, capped by the
+// importance of that split). Keeping the vertices with importance >= tolerance gives exactly the
+// DP result for that tolerance, in one O(n) pass at any zoom; ends of a part are +inf.
+class LineSimplifier : public godot::RefCounted {
+    GDCLASS(LineSimplifier, godot::RefCounted);
+  public:
+    // `xy` interleaved, `count` vertices; `importance` receives `count` values
+    static void compute(const double *xy, int64_t count, float *importance);
+    // Copies the vertices of [xy, count) with importance >= tolerance to `out`, returns how many
+    static int64_t select(const double *xy, const float *importance, int64_t count, double tolerance, double *out);
+
+    // load_paths output
+    static godot::PackedFloat32Array compute_path_importance(const godot::PackedVector2Array &path);
+    static godot::PackedVector2Array simplify_path(const godot::PackedVector2Array &path, const godot::PackedFloat32Array &importance, double tolerance);
+
+    // load_geometries output: one value per vertex, each part on its own (points parts keep +inf)
+    static godot::PackedFloat32Array compute_importance(const godot::Dictionary &geometries);
+    // Same layout with the vertices below `tolerance` removed; rings reduced below a triangle are
+    // dropped, with their holes, and features left without any part keep an empty entry
+    static godot::Dictionary simplify_geometries(const godot::Dictionary &geometries, const godot::PackedFloat32Array &importance, double tolerance);
+
+  protected:
+    static void _bind_methods();
+};
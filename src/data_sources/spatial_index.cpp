@@ -0,0 +1,411 @@
+#include "spatial_index.hpp"
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <queue>
+using namespace godot;
+
+namespace {
+
+constexpr uint32_t SPATIAL_INDEX_MAGIC = 0x58444953; // "SIDX"
+constexpr uint32_t SPATIAL_INDEX_VERSION = 1;
+constexpr uint32_t HILBERT_MAX = (1 << 16) - 1;
+
+// Hilbert curve index of (x, y) on a 2^16 grid (Warren, "Hacker's Delight" non-recursive form)
+uint32_t hilbert(uint32_t x, uint32_t y) {
+    uint32_t a = x ^ y;
+    uint32_t b = 0xFFFF ^ a;
+    uint32_t c = 0xFFFF ^ (x | y);
+    uint32_t d = x & (y ^ 0xFFFF);
+
+    uint32_t A = a | (b >> 1);
+    uint32_t B = (a >> 1) ^ a;
+    uint32_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+    uint32_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+    a = A; b = B; c = C; d = D;
+    A = (a & (a >> 2)) ^ (b & (b >> 2));
+    B = (a & (b >> 2)) ^ (b & ((a ^ b) >> 2));
+    C ^= (a & (c >> 2)) ^ (b & (d >> 2));
+    D ^= (b & (c >> 2)) ^ ((a ^ b) & (d >> 2));
+
+    a = A; b = B; c = C; d = D;
+    A = (a & (a >> 4)) ^ (b & (b >> 4));
+    B = (a & (b >> 4)) ^ (b & ((a ^ b) >> 4));
+    C ^= (a & (c >> 4)) ^ (b & (d >> 4));
+    D ^= (b & (c >> 4)) ^ ((a ^ b) & (d >> 4));
+
+    a = A; b = B; c = C; d = D;
+    C ^= (a & (c >> 8)) ^ (b & (d >> 8));
+    D ^= (b & (c >> 8)) ^ ((a ^ b) & (d >> 8));
+
+    a = C ^ (C >> 1);
+    b = D ^ (D >> 1);
+
+    uint32_t i0 = x ^ y;
+    uint32_t i1 = b | (0xFFFF ^ (i0 | a));
+
+    i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+    i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+    i0 = (i0 | (i0 << 2)) & 0x33333333;
+    i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+    i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+    i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+    i1 = (i1 | (i1 << 2)) & 0x33333333;
+    i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+    return (i1 << 1) | i0;
+}
+
+// Squared distance from (x, y) to a box (0 inside)
+inline double box_distance_squared(double x, double y, const double *box) {
+    const double dx = x < box[0] ? box[0] - x : (x > box[2] ? x - box[2] : 0.0);
+    const double dy = y < box[1] ? box[1] - y : (y > box[3] ? y - box[3] : 0.0);
+    return dx * dx + dy * dy;
+}
+
+struct QueueEntry {
+    double distance;
+    int32_t id;     // item id, or box offset of a node
+    bool is_item;
+    bool operator>(const QueueEntry &o) const { return distance > o.distance; }
+};
+
+} // namespace
+
+void SpatialIndex::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("reset", "item_count", "node_size"), &SpatialIndex::reset, DEFVAL(DEFAULT_NODE_SIZE));
+    ClassDB::bind_method(D_METHOD("add", "min_x", "min_y", "max_x", "max_y"), &SpatialIndex::add);
+    ClassDB::bind_method(D_METHOD("finish"), &SpatialIndex::finish);
+    ClassDB::bind_method(D_METHOD("build_from_geometries", "geometries", "node_size"), &SpatialIndex::build_from_geometries, DEFVAL(DEFAULT_NODE_SIZE));
+    ClassDB::bind_method(D_METHOD("search", "min_x", "min_y", "max_x", "max_y"), &SpatialIndex::search);
+    ClassDB::bind_method(D_METHOD("neighbors", "x", "y", "max_results", "max_distance"), &SpatialIndex::neighbors, DEFVAL(1), DEFVAL(-1.0));
+    ClassDB::bind_method(D_METHOD("get_item_count"), &SpatialIndex::get_item_count);
+    ClassDB::bind_method(D_METHOD("is_finished"), &SpatialIndex::is_finished);
+    ClassDB::bind_method(D_METHOD("to_bytes"), &SpatialIndex::to_bytes);
+    ClassDB::bind_method(D_METHOD("from_bytes", "bytes"), &SpatialIndex::from_bytes);
+    ClassDB::bind_method(D_METHOD("save", "path"), &SpatialIndex::save);
+    ClassDB::bind_method(D_METHOD("load", "path"), &SpatialIndex::load);
+}
+
+void SpatialIndex::compute_level_bounds() {
+    // Items first, then each level of ceil(n / node_size) parents, up to a single root
+    level_bounds.clear();
+    int64_t n = num_items;
+    int64_t num_nodes = n;
+    level_bounds.push_back(n * 4);
+    do {
+        n = (n + node_size - 1) / node_size;
+        num_nodes += n;
+        level_bounds.push_back(num_nodes * 4);
+    } while (n > 1);
+    boxes.assign(num_nodes * 4, 0.0);
+    indices.assign(num_nodes, 0);
+}
+
+void SpatialIndex::reset(int item_count, int p_node_size) {
+    ERR_FAIL_COND(item_count < 0);
+    num_items = item_count;
+    node_size = CLAMP(p_node_size, 2, 65535);
+    num_added = 0;
+    finished = false;
+    bounds[0] = bounds[1] = std::numeric_limits<double>::infinity();
+    bounds[2] = bounds[3] = -std::numeric_limits<double>::infinity();
+    compute_level_bounds();
+}
+
+int SpatialIndex::add(double min_x, double min_y, double max_x, double max_y) {
+    ERR_FAIL_COND_V_MSG(finished, -1, "SpatialIndex already finished, call reset() first");
+    ERR_FAIL_COND_V_MSG(num_added >= num_items, -1, "More boxes added than announced in reset()");
+    const int id = num_added++;
+    double *box = boxes.data() + int64_t(id) * 4;
+    box[0] = min_x;
+    box[1] = min_y;
+    box[2] = max_x;
+    box[3] = max_y;
+    indices[id] = id;
+    // Empty boxes (min > max) never match a query and stay out of the bounds
+    if (min_x <= max_x && min_y <= max_y) {
+        bounds[0] = MIN(bounds[0], min_x);
+        bounds[1] = MIN(bounds[1], min_y);
+        bounds[2] = MAX(bounds[2], max_x);
+        bounds[3] = MAX(bounds[3], max_y);
+    }
+    return id;
+}
+
+void SpatialIndex::finish() {
+    ERR_FAIL_COND_MSG(finished, "SpatialIndex already finished");
+    ERR_FAIL_COND_MSG(num_added != num_items, "SpatialIndex::finish() before all the boxes announced in reset() were added");
+
+    if (num_items == 0) {
+        finished = true;
+        return;
+    }
+
+    // Sort the items along the Hilbert curve of their centres
+    const double width = bounds[2] - bounds[0];
+    const double height = bounds[3] - bounds[1];
+    const double sx = width > 0.0 ? HILBERT_MAX / width : 0.0;
+    const double sy = height > 0.0 ? HILBERT_MAX / height : 0.0;
+    std::vector<uint32_t> keys(num_items);
+    for (int i = 0; i < num_items; ++i) {
+        const double *box = boxes.data() + int64_t(i) * 4;
+        if (!(box[0] <= box[2] && box[1] <= box[3])) {
+            keys[i] = 0;
+            continue;
+        }
+        const double cx = 0.5 * (box[0] + box[2]) - bounds[0];
+        const double cy = 0.5 * (box[1] + box[3]) - bounds[1];
+        keys[i] = hilbert(uint32_t(CLAMP(cx * sx, 0.0, double(HILBERT_MAX))), uint32_t(CLAMP(cy * sy, 0.0, double(HILBERT_MAX))));
+    }
+    std::vector<int32_t> order(num_items);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](int32_t a, int32_t b) { return keys[a] < keys[b]; });
+
+    std::vector<double> sorted_boxes(int64_t(num_items) * 4);
+    for (int i = 0; i < num_items; ++i) {
+        std::memcpy(sorted_boxes.data() + int64_t(i) * 4, boxes.data() + int64_t(order[i]) * 4, 4 * sizeof(double));
+        indices[i] = order[i];
+    }
+    std::memcpy(boxes.data(), sorted_boxes.data(), sorted_boxes.size() * sizeof(double));
+
+    // Pack each level into parents of node_size children; parents store their first child's offset
+    int64_t pos = 0;
+    for (size_t level = 0; level + 1 < level_bounds.size(); ++level) {
+        const int64_t end = level_bounds[level];
+        int64_t parent = end;
+        while (pos < end) {
+            const int64_t first_child = pos;
+            double node[4] = {
+                std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+                -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()
+            };
+            for (int k = 0; k < node_size && pos < end; ++k, pos += 4) {
+                node[0] = MIN(node[0], boxes[pos + 0]);
+                node[1] = MIN(node[1], boxes[pos + 1]);
+                node[2] = MAX(node[2], boxes[pos + 2]);
+                node[3] = MAX(node[3], boxes[pos + 3]);
+            }
+            std::memcpy(boxes.data() + parent, node, sizeof(node));
+            indices[parent >> 2] = int32_t(first_child);
+            parent += 4;
+        }
+    }
+    finished = true;
+}
+
+int64_t SpatialIndex::upper_bound(int64_t node_index) const {
+    // End of the level containing node_index
+    return *std::upper_bound(level_bounds.begin(), level_bounds.end(), node_index);
+}
+
+Error SpatialIndex::build_from_geometries(const Dictionary &geometries, int p_node_size) {
+    const PackedFloat64Array coords = geometries.get("coords", PackedFloat64Array());
+    const PackedInt32Array part_offsets = geometries.get("part_offsets", PackedInt32Array());
+    const PackedInt32Array feature_offsets = geometries.get("feature_offsets", PackedInt32Array());
+    ERR_FAIL_COND_V_MSG(feature_offsets.is_empty() || part_offsets.is_empty(), ERR_INVALID_PARAMETER,
+            "Expected the output of VectorSource.load_geometries");
+
+    const int feature_count = int(feature_offsets.size() - 1);
+    reset(feature_count, p_node_size);
+    const double *xy = coords.ptr();
+    const int32_t *parts = part_offsets.ptr();
+    const int32_t *features = feature_offsets.ptr();
+    for (int f = 0; f < feature_count; ++f) {
+        double box[4] = {
+            std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+            -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()
+        };
+        // Parts of a feature are contiguous: one pass over its vertex range
+        const int64_t v0 = parts[features[f]];
+        const int64_t v1 = parts[features[f + 1]];
+        for (int64_t v = v0; v < v1; ++v) {
+            box[0] = MIN(box[0], xy[v * 2]);
+            box[1] = MIN(box[1], xy[v * 2 + 1]);
+            box[2] = MAX(box[2], xy[v * 2]);
+            box[3] = MAX(box[3], xy[v * 2 + 1]);
+        }
+        add(box[0], box[1], box[2], box[3]);
+    }
+    finish();
+    return OK;
+}
+
+PackedInt32Array SpatialIndex::search(double min_x, double min_y, double max_x, double max_y) const {
+    PackedInt32Array results;
+    ERR_FAIL_COND_V_MSG(!finished, results, "SpatialIndex not finished");
+    if (num_items == 0) {
+        return results;
+    }
+
+    std::vector<int64_t> stack;
+    std::vector<int32_t> found;
+    int64_t node_index = int64_t(boxes.size()) - 4;
+    for (;;) {
+        const int64_t end = MIN(node_index + int64_t(node_size) * 4, upper_bound(node_index));
+        const bool leaf_level = node_index < int64_t(num_items) * 4;
+        for (int64_t pos = node_index; pos < end; pos += 4) {
+            const double *box = boxes.data() + pos;
+            if (max_x < box[0] || max_y < box[1] || min_x > box[2] || min_y > box[3]) {
+                continue;
+            }
+            if (leaf_level) {
+                found.push_back(indices[pos >> 2]);
+            } else {
+                stack.push_back(indices[pos >> 2]);
+            }
+        }
+        if (stack.empty()) {
+            break;
+        }
+        node_index = stack.back();
+        stack.pop_back();
+    }
+
+    results.resize(int64_t(found.size()));
+    if (!found.empty()) {
+        std::memcpy(results.ptrw(), found.data(), found.size() * sizeof(int32_t));
+    }
+    return results;
+}
+
+PackedInt32Array SpatialIndex::neighbors(double x, double y, int max_results, double max_distance) const {
+    PackedInt32Array results;
+    ERR_FAIL_COND_V_MSG(!finished, results, "SpatialIndex not finished");
+    if (num_items == 0 || max_results <= 0) {
+        return results;
+    }
+    const double max_d2 = max_distance < 0.0 ? std::numeric_limits<double>::infinity() : max_distance * max_distance;
+
+    // Best-first: nodes and items share one queue ordered by box distance
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    std::vector<int32_t> found;
+    int64_t node_index = int64_t(boxes.size()) - 4;
+    for (;;) {
+        const int64_t end = MIN(node_index + int64_t(node_size) * 4, upper_bound(node_index));
+        const bool leaf_level = node_index < int64_t(num_items) * 4;
+        for (int64_t pos = node_index; pos < end; pos += 4) {
+            const double *box = boxes.data() + pos;
+            if (!(box[0] <= box[2] && box[1] <= box[3])) {
+                continue; // empty feature
+            }
+            const double d2 = box_distance_squared(x, y, box);
+            if (d2 <= max_d2) {
+                queue.push({ d2, indices[pos >> 2], leaf_level });
+            }
+        }
+        // Every item closer than the nearest pending node is final
+        while (!queue.empty() && queue.top().is_item && int(found.size()) < max_results) {
+            found.push_back(queue.top().id);
+            queue.pop();
+        }
+        if (queue.empty() || int(found.size()) >= max_results) {
+            break;
+        }
+        node_index = queue.top().id;
+        queue.pop();
+    }
+
+    results.resize(int64_t(found.size()));
+    if (!found.empty()) {
+        std::memcpy(results.ptrw(), found.data(), found.size() * sizeof(int32_t));
+    }
+    return results;
+}
+
+// Serialized layout (native byte order, little endian on every platform Godot ships on; a file
+// from a big-endian host fails the magic check): magic, version, node_size, item_count (uint32
+// each), then the boxes (4 doubles per node) and the indices (int32 per node). Level bounds are rebuilt.
+PackedByteArray SpatialIndex::to_bytes() const {
+    PackedByteArray bytes;
+    ERR_FAIL_COND_V_MSG(!finished, bytes, "SpatialIndex not finished");
+    const int64_t header = 4 * sizeof(uint32_t);
+    const int64_t box_bytes = int64_t(boxes.size()) * sizeof(double);
+    const int64_t index_bytes = int64_t(indices.size()) * sizeof(int32_t);
+    bytes.resize(header + box_bytes + index_bytes);
+    uint8_t *w = bytes.ptrw();
+    const uint32_t head[4] = { SPATIAL_INDEX_MAGIC, SPATIAL_INDEX_VERSION, uint32_t(node_size), uint32_t(num_items) };
+    std::memcpy(w, head, header);
+    std::memcpy(w + header, boxes.data(), box_bytes);
+    std::memcpy(w + header + box_bytes, indices.data(), index_bytes);
+    return bytes;
+}
+
+Error SpatialIndex::from_bytes(const PackedByteArray &bytes) {
+    const int64_t header = 4 * sizeof(uint32_t);
+    ERR_FAIL_COND_V_MSG(bytes.size() < header, ERR_FILE_CORRUPT, "SpatialIndex data too short");
+    uint32_t head[4];
+    std::memcpy(head, bytes.ptr(), header);
+    ERR_FAIL_COND_V_MSG(head[0] != SPATIAL_INDEX_MAGIC, ERR_FILE_UNRECOGNIZED, "Not a SpatialIndex");
+    ERR_FAIL_COND_V_MSG(head[1] != SPATIAL_INDEX_VERSION, ERR_FILE_UNRECOGNIZED, "Unsupported SpatialIndex version");
+    ERR_FAIL_COND_V_MSG(head[2] < 2 || head[2] > 65535 || head[3] > uint32_t(std::numeric_limits<int32_t>::max()),
+            ERR_FILE_CORRUPT, "SpatialIndex header out of range");
+
+    // Check the size the header implies before allocating anything; box offsets must fit in int32
+    int64_t n = head[3];
+    int64_t num_nodes = n;
+    do {
+        n = (n + head[2] - 1) / head[2];
+        num_nodes += n;
+    } while (n > 1);
+    ERR_FAIL_COND_V_MSG(num_nodes * 4 > std::numeric_limits<int32_t>::max(), ERR_FILE_CORRUPT, "SpatialIndex too large");
+    ERR_FAIL_COND_V_MSG(bytes.size() != header + num_nodes * int64_t(4 * sizeof(double) + sizeof(int32_t)), ERR_FILE_CORRUPT,
+            "SpatialIndex data size does not match its header");
+
+    num_items = int(head[3]);
+    node_size = int(head[2]);
+    compute_level_bounds();
+    const int64_t box_bytes = int64_t(boxes.size()) * sizeof(double);
+    const int64_t index_bytes = int64_t(indices.size()) * sizeof(int32_t);
+    std::memcpy(boxes.data(), bytes.ptr() + header, box_bytes);
+    std::memcpy(indices.data(), bytes.ptr() + header + box_bytes, index_bytes);
+
+    // Queries follow the indices blindly: leaves must name an item, every internal node must
+    // point at a box of the level right below it (which also rules out cycles)
+    bool valid = true;
+    for (int64_t i = 0; i < num_items && valid; ++i) {
+        valid = indices[i] >= 0 && indices[i] < num_items;
+    }
+    for (size_t level = 1; level < level_bounds.size() && valid; ++level) {
+        const int64_t child_begin = level == 1 ? 0 : level_bounds[level - 2];
+        const int64_t child_end = level_bounds[level - 1];
+        for (int64_t pos = level_bounds[level - 1]; pos < level_bounds[level] && valid; pos += 4) {
+            const int64_t child = indices[pos >> 2];
+            valid = child >= child_begin && child < child_end && (child & 3) == 0;
+        }
+    }
+    if (!valid) {
+        reset(0);
+        ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "SpatialIndex node indices out of range");
+    }
+    num_added = num_items;
+    finished = true;
+    return OK;
+}
+
+Error SpatialIndex::save(const String &path) const {
+    ERR_FAIL_COND_V_MSG(!finished, ERR_UNCONFIGURED, "SpatialIndex not finished");
+    Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+    if (file.is_null()) {
+        UtilityFunctions::printerr("Cannot write spatial index: ", path);
+        return FileAccess::get_open_error();
+    }
+    file->store_buffer(to_bytes());
+    return OK;
+}
+
+Error SpatialIndex::load(const String &path) {
+    Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
+    if (file.is_null()) {
+        return FileAccess::get_open_error();
+    }
+    return from_bytes(file->get_buffer(int64_t(file->get_length())));
+}
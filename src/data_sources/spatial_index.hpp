@@ -0,0 +1,58 @@
+#pragma once
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Static packed Hilbert R-tree over bounding boxes (same layout as flatbush): items are sorted
+// along a Hilbert curve and packed bottom-up in nodes of node_size children, all boxes in one
+// flat double array. Built once (add… then finish, or build_from_geometries), then queried by
+// box or by distance; to_bytes / save store the finished tree next to the dataset.
+class SpatialIndex : public godot::RefCounted {
+    GDCLASS(SpatialIndex, godot::RefCounted);
+  public:
+    static constexpr int DEFAULT_NODE_SIZE = 16;
+
+    // Start a new index for `item_count` boxes
+    void reset(int item_count, int node_size = DEFAULT_NODE_SIZE);
+    // Returns the item id (insertion order)
+    int add(double min_x, double min_y, double max_x, double max_y);
+    void finish();
+
+    // One box per feature of a VectorSource::load_geometries result (ids = feature indices)
+    godot::Error build_from_geometries(const godot::Dictionary &geometries, int node_size = DEFAULT_NODE_SIZE);
+
+    // Ids of the items whose box intersects the query box
+    godot::PackedInt32Array search(double min_x, double min_y, double max_x, double max_y) const;
+    // Up to `max_results` ids ordered by box distance to (x, y), within max_distance (< 0: unlimited)
+    godot::PackedInt32Array neighbors(double x, double y, int max_results = 1, double max_distance = -1.0) const;
+
+    int get_item_count() const { return num_items; }
+    bool is_finished() const { return finished; }
+
+    godot::PackedByteArray to_bytes() const;
+    godot::Error from_bytes(const godot::PackedByteArray &bytes);
+    godot::Error save(const godot::String &path) const;
+    godot::Error load(const godot::String &path);
+
+  protected:
+    static void _bind_methods();
+
+  private:
+    int num_items = 0;
+    int node_size = DEFAULT_NODE_SIZE;
+    int num_added = 0;
+    bool finished = false;
+
+    std::vector<double> boxes;           // 4 per node: items first, then each level up to the root
+    std::vector<int32_t> indices;        // item id (leaves) or first child box offset (internal nodes)
+    std::vector<int64_t> level_bounds;   // end offset (in boxes) of each level
+    double bounds[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+    void compute_level_bounds();
+    int64_t upper_bound(int64_t node_index) const;
+};
@@ -0,0 +1,188 @@
+#include "vector_geometry_buffer.hpp"
+
+#include <godot_cpp/core/error_macros.hpp>
+
+#include <ogrsf_frmts.h>
+
+#include <memory>
+
+using namespace godot;
+
+void VectorGeometryBuffer::set_attribute_fields(const std::vector<std::string> &names) {
+    field_names = names;
+    field_indices.assign(names.size(), -1);
+    field_values.assign(names.size(), Array());
+}
+
+void VectorGeometryBuffer::bind_layer(OGRFeatureDefn *defn) {
+    for (size_t k = 0; k < field_names.size(); ++k) {
+        field_indices[k] = defn->GetFieldIndex(field_names[k].c_str());
+    }
+}
+
+void VectorGeometryBuffer::begin_layer(int64_t expected_features) {
+    layer_offsets.push_back(int32_t(get_feature_count()));
+    if (expected_features > 0) {
+        const int64_t features = get_feature_count() + expected_features;
+        feature_offsets.reserve(features);
+        geometry_types.reserve(features);
+        fids.reserve(features);
+    }
+}
+
+double *VectorGeometryBuffer::add_part(PartKind kind, int64_t vertex_count) {
+    part_offsets.push_back(int32_t(get_vertex_count()));
+    part_kinds.push_back(kind);
+    return coords.grow(vertex_count * 2);
+}
+
+void VectorGeometryBuffer::add_curve(const OGRSimpleCurve *curve, PartKind kind) {
+    const int n = curve->getNumPoints();
+    if (n == 0) return;
+    // OGRRawPoint is { double x, y }: bulk copy straight into the interleaved buffer
+    curve->getPoints(reinterpret_cast<OGRRawPoint *>(add_part(kind, n)), nullptr);
+}
+
+void VectorGeometryBuffer::add_geometry(const OGRGeometry *geom) {
+    const OGRwkbGeometryType type = wkbFlatten(geom->getGeometryType());
+    switch (type) {
+        case wkbPoint: {
+            const OGRPoint *pt = geom->toPoint();
+            if (pt->IsEmpty()) return;
+            double *dst = add_part(PART_POINTS, 1);
+            dst[0] = pt->getX();
+            dst[1] = pt->getY();
+        } break;
+        case wkbLineString:
+        case wkbLinearRing: {
+            add_curve(geom->toSimpleCurve(), PART_LINE);
+        } break;
+        case wkbPolygon:
+        case wkbTriangle: {
+            const OGRPolygon *poly = geom->toPolygon();
+            const OGRLinearRing *exterior = poly->getExteriorRing();
+            if (!exterior) return;
+            add_curve(exterior, PART_EXTERIOR_RING);
+            for (int r = 0; r < poly->getNumInteriorRings(); ++r) {
+                add_curve(poly->getInteriorRing(r), PART_INTERIOR_RING);
+            }
+        } break;
+        case wkbMultiPoint:
+        case wkbMultiLineString:
+        case wkbMultiPolygon:
+        case wkbGeometryCollection: {
+            const OGRGeometryCollection *coll = geom->toGeometryCollection();
+            for (int g = 0; g < coll->getNumGeometries(); ++g) {
+                add_geometry(coll->getGeometryRef(g));
+            }
+        } break;
+        case wkbPolyhedralSurface:
+        case wkbTIN: {
+            // Faces are plain polygons: converted once to a multipolygon (the factory takes the clone)
+            std::unique_ptr<OGRGeometry> faces(OGRGeometryFactory::forceToMultiPolygon(geom->clone()));
+            ERR_FAIL_COND_MSG(!faces || wkbFlatten(faces->getGeometryType()) != wkbMultiPolygon,
+                              String("Could not convert ") + geom->getGeometryName() + " to a multipolygon.");
+            add_geometry(faces.get());
+        } break;
+        default: {
+            // Circular strings, compound curves, curve polygons, surfaces…: linearised once
+            if (geom->hasCurveGeometry() || OGR_GT_IsSurface(type) || OGR_GT_IsCurve(type)) {
+                std::unique_ptr<OGRGeometry> linear(geom->getLinearGeometry());
+                if (linear && wkbFlatten(linear->getGeometryType()) != type) {
+                    add_geometry(linear.get());
+                    return;
+                }
+            }
+            ERR_PRINT(String("Unsupported geometry type ") + geom->getGeometryName() + ", geometry skipped.");
+        } break;
+    }
+}
+
+void VectorGeometryBuffer::add_feature(OGRFeature *feature) {
+    feature_offsets.push_back(int32_t(part_offsets.size()));
+    fids.push_back(feature->GetFID());
+
+    for (size_t k = 0; k < field_names.size(); ++k) {
+        const int f = field_indices[k];
+        Variant value;
+        if (f >= 0 && feature->IsFieldSetAndNotNull(f)) {
+            switch (feature->GetFieldDefnRef(f)->GetType()) {
+                case OFTInteger:
+                case OFTInteger64:
+                    value = feature->GetFieldAsInteger64(f);
+                    break;
+                case OFTReal:
+                    value = feature->GetFieldAsDouble(f);
+                    break;
+                default:
+                    value = String::utf8(feature->GetFieldAsString(f));
+                    break;
+            }
+        }
+        field_values[k].push_back(value);
+    }
+
+    const OGRGeometry *geom = feature->GetGeometryRef();
+    if (!geom) {
+        geometry_types.push_back(uint8_t(wkbUnknown));
+        return;
+    }
+    OGRwkbGeometryType type = wkbFlatten(geom->getGeometryType());
+    // Report curve types with their linear equivalent (CircularString -> LineString, …)
+    type = wkbFlatten(OGR_GT_GetLinear(type));
+    geometry_types.push_back(uint8_t(type));
+    add_geometry(geom);
+}
+
+void VectorGeometryBuffer::append(VectorGeometryBuffer &other) {
+    const int32_t vertex_base = int32_t(get_vertex_count());
+    const int32_t part_base = int32_t(part_offsets.size());
+    const int32_t feature_base = int32_t(get_feature_count());
+
+    auto copy = [](auto &dst, auto &src, auto shift) {
+        const int64_t n = src.size();
+        auto *d = dst.grow(n);
+        const auto *s = src.ptr();
+        for (int64_t i = 0; i < n; ++i) {
+            d[i] = s[i] + shift;
+        }
+    };
+    copy(coords, other.coords, 0.0);
+    copy(part_offsets, other.part_offsets, vertex_base);
+    copy(part_kinds, other.part_kinds, uint8_t(0));
+    copy(feature_offsets, other.feature_offsets, part_base);
+    copy(geometry_types, other.geometry_types, uint8_t(0));
+    copy(fids, other.fids, int64_t(0));
+    copy(layer_offsets, other.layer_offsets, feature_base);
+
+    if (field_names.empty() && !other.field_names.empty()) {
+        set_attribute_fields(other.field_names);
+    }
+    for (size_t k = 0; k < field_values.size() && k < other.field_values.size(); ++k) {
+        field_values[k].append_array(other.field_values[k]);
+    }
+}
+
+Dictionary VectorGeometryBuffer::to_dictionary() {
+    // Closing sentinels so that [offsets[i], offsets[i + 1]) is always valid
+    part_offsets.push_back(int32_t(get_vertex_count()));
+    feature_offsets.push_back(int32_t(part_kinds.size()));
+    layer_offsets.push_back(int32_t(get_feature_count()));
+
+    Dictionary res;
+    res["coords"] = coords.finish();
+    res["part_offsets"] = part_offsets.finish();
+    res["part_kinds"] = part_kinds.finish();
+    res["feature_offsets"] = feature_offsets.finish();
+    res["geometry_types"] = geometry_types.finish();
+    res["fids"] = fids.finish();
+    res["layer_offsets"] = layer_offsets.finish();
+    if (!field_names.empty()) {
+        Dictionary attributes;
+        for (size_t k = 0; k < field_names.size(); ++k) {
+            attributes[String::utf8(field_names[k].c_str())] = field_values[k];
+        }
+        res["attributes"] = attributes;
+    }
+    return res;
+}
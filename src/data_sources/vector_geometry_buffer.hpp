@@ -0,0 +1,107 @@
+#pragma once
+
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class OGRFeature;
+class OGRFeatureDefn;
+class OGRGeometry;
+class OGRSimpleCurve;
+
+// Packed array filled in place with geometric growth: a handful of reallocations for the whole
+// load, no per-element set(), and the final array is handed out without a copy.
+template <typename TPacked, typename T>
+class GrowablePacked {
+public:
+    int64_t size() const { return count; }
+    void reserve(int64_t n) {
+        if (n > data.size()) {
+            data.resize(n);
+        }
+    }
+    // Pointer to `n` new elements at the end
+    T *grow(int64_t n) {
+        if (count + n > data.size()) {
+            data.resize(MAX(count + n, MAX(data.size() * 2, int64_t(64))));
+        }
+        T *p = data.ptrw() + count;
+        count += n;
+        return p;
+    }
+    void push_back(T v) { *grow(1) = v; }
+    // Drops the elements past `n` (the storage stays for the next grow)
+    void truncate(int64_t n) { count = MIN(count, n); }
+    T operator[](int64_t i) const { return data[i]; }
+    const T *ptr() const { return data.ptr(); }
+    TPacked finish() {
+        data.resize(count);
+        return data;
+    }
+
+private:
+    TPacked data;
+    int64_t count = 0;
+};
+
+// Typed, flat geometry of a vector dataset (all OGR geometry types). Layout of to_dictionary():
+// - "coords"          PackedFloat64Array  x, y interleaved (dataset CRS)
+// - "part_offsets"    PackedInt32Array    first vertex of each part, + final vertex count
+// - "part_kinds"      PackedByteArray     PART_* per part
+// - "feature_offsets" PackedInt32Array    first part of each feature, + final part count
+// - "geometry_types"  PackedByteArray     flattened OGRwkbGeometryType per feature (1 point … 7 collection)
+// - "fids"            PackedInt64Array    OGR feature id per feature
+// - "layer_offsets"   PackedInt32Array    first feature of each layer, + final feature count
+// - "attributes"      Dictionary          field name -> Array (one value per feature), only for
+//                                         the fields passed to set_attribute_fields
+// Curves are linearised; features without geometry keep an entry with no part.
+class VectorGeometryBuffer {
+public:
+    enum PartKind : uint8_t {
+        PART_POINTS = 0,
+        PART_LINE = 1,
+        PART_EXTERIOR_RING = 2,
+        PART_INTERIOR_RING = 3,
+    };
+
+    // Attribute columns to collect (before the first feature)
+    void set_attribute_fields(const std::vector<std::string> &names);
+    void begin_layer(int64_t expected_features = 0);
+    // Resolve the attribute columns against the layer being read (every partition of a layer)
+    void bind_layer(OGRFeatureDefn *defn);
+    void add_feature(OGRFeature *feature);
+    // Append another buffer (e.g. from a worker), shifting its offsets. Both must not have been
+    // turned into a dictionary yet.
+    void append(VectorGeometryBuffer &other);
+
+    int64_t get_feature_count() const { return geometry_types.size(); }
+    int64_t get_vertex_count() const { return coords.size() / 2; }
+
+    godot::Dictionary to_dictionary();
+
+private:
+    GrowablePacked<godot::PackedFloat64Array, double> coords;
+    GrowablePacked<godot::PackedInt32Array, int32_t> part_offsets;
+    GrowablePacked<godot::PackedByteArray, uint8_t> part_kinds;
+    GrowablePacked<godot::PackedInt32Array, int32_t> feature_offsets;
+    GrowablePacked<godot::PackedByteArray, uint8_t> geometry_types;
+    GrowablePacked<godot::PackedInt64Array, int64_t> fids;
+    GrowablePacked<godot::PackedInt32Array, int32_t> layer_offsets;
+
+    std::vector<std::string> field_names;
+    std::vector<int> field_indices; // in the bound layer, -1 when missing
+    std::vector<godot::Array> field_values;
+
+    void add_geometry(const OGRGeometry *geom);
+    // The kind is explicit: OGRLinearRing reports wkbLineString, so rings cannot be told apart by type
+    void add_curve(const OGRSimpleCurve *curve, PartKind kind);
+    // Registers a part and returns its (uninitialised) x, y slots
+    double *add_part(PartKind kind, int64_t vertex_count);
+};
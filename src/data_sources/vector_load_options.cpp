@@ -0,0 +1,52 @@
+#include "vector_load_options.hpp"
+#include <godot_cpp/variant/utility_functions.hpp>
+#include <ogrsf_frmts.h>
+#include <algorithm>
+#include <string>
+using namespace godot;
+
+bool VectorLoadOptions::apply(OGRLayer *layer) const {
+    if (has_spatial_filter) {
+        layer->SetSpatialFilterRect(min_x, min_y, max_x, max_y);
+    } else {
+        layer->SetSpatialFilter(nullptr);
+    }
+
+    if (layer->SetAttributeFilter(attribute_filter.empty() ? nullptr : attribute_filter.c_str()) != OGRERR_NONE) {
+        UtilityFunctions::printerr("Invalid attribute filter for layer ", layer->GetName(), ": ", attribute_filter.c_str());
+        return false;
+    }
+
+    OGRFeatureDefn *defn = layer->GetLayerDefn();
+
+    // Fields read by the WHERE clause: drivers without native SQL evaluate it on the decoded
+    // feature, where an ignored field is unset and would silently reject every feature
+    std::vector<std::string> filter_fields;
+    if (!attribute_filter.empty()) {
+        OGRFeatureQuery query;
+        if (query.Compile(defn, attribute_filter.c_str()) != OGRERR_NONE) {
+            // Accepted by the driver but not by the generic OGR SQL parser: keep every field rather than guess
+            layer->SetIgnoredFields(nullptr);
+            return true;
+        }
+        char **used = query.GetUsedFields();
+        for (char **it = used; it && *it; ++it) {
+            filter_fields.push_back(*it);
+        }
+        CSLDestroy(used);
+    }
+
+    // Ignore every attribute field that was neither asked for nor filtered on (and the style string); the geometry is kept
+    std::vector<const char *> ignored;
+    for (int f = 0; f < defn->GetFieldCount(); ++f) {
+        const char *name = defn->GetFieldDefn(f)->GetNameRef();
+        if (std::find(selected_fields.begin(), selected_fields.end(), name) == selected_fields.end() &&
+            std::find(filter_fields.begin(), filter_fields.end(), name) == filter_fields.end()) {
+            ignored.push_back(name);
+        }
+    }
+    ignored.push_back("OGR_STYLE");
+    ignored.push_back(nullptr);
+    layer->SetIgnoredFields(ignored.data());
+    return true;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class OGRLayer;
+
+// Filters pushed down into OGR by every VectorSource loader (serial, async and per partition):
+// the driver can use its spatial index, evaluate the WHERE clause natively and skip decoding
+// the attribute fields that are not requested.
+struct VectorLoadOptions {
+    bool has_spatial_filter = false;
+    double min_x = 0.0, min_y = 0.0, max_x = 0.0, max_y = 0.0; // layer CRS
+
+    std::string attribute_filter; // OGR SQL WHERE clause, empty = none
+
+    // Attribute fields to read and return; every other field is ignored (none read when empty)
+    std::vector<std::string> selected_fields;
+
+    bool has_feature_filters() const { return has_spatial_filter || !attribute_filter.empty(); }
+
+    // Returns false (with an error printed) when the attribute filter is rejected
+    bool apply(OGRLayer *layer) const;
+};
@@ -0,0 +1,138 @@
+#include "vector_load_task.hpp"
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+#include <gdal_priv.h>
+#include <ogrsf_frmts.h>
+using namespace godot;
+
+VectorLoadTask::VectorLoadTask() {}
+
+VectorLoadTask::~VectorLoadTask() {
+    // Workers write into `partitions`: they must be done before it goes away
+    cancel();
+    wait();
+}
+
+void VectorLoadTask::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("is_completed"), &VectorLoadTask::is_completed);
+    ClassDB::bind_method(D_METHOD("get_progress"), &VectorLoadTask::get_progress);
+    ClassDB::bind_method(D_METHOD("cancel"), &VectorLoadTask::cancel);
+    ClassDB::bind_method(D_METHOD("wait"), &VectorLoadTask::wait);
+    ClassDB::bind_method(D_METHOD("get_result"), &VectorLoadTask::get_result);
+}
+
+Ref<VectorLoadTask> VectorLoadTask::start(const String &path, const VectorLoadOptions &options, int thread_count) {
+    Ref<VectorLoadTask> task;
+    task.instantiate();
+    task->options = options;
+    task->real_path = ProjectSettings::get_singleton()->globalize_path(path).utf8().get_data();
+
+    GDALDataset *ds = (GDALDataset*) GDALOpenEx(task->real_path.c_str(), GDAL_OF_VECTOR, nullptr, nullptr, nullptr);
+    if (!ds) {
+        UtilityFunctions::printerr("GDALOpenEx failed: ", String(task->real_path.c_str()));
+        return task; // completed, empty result
+    }
+
+    if (thread_count <= 0) {
+        thread_count = OS::get_singleton()->get_processor_count();
+    }
+
+    // Plan: a layer is split by feature index only when it can be counted and sought cheaply
+    int64_t total = 0;
+    for (int i = 0; i < ds->GetLayerCount(); ++i) {
+        OGRLayer *layer = ds->GetLayer(i);
+        if (!layer || !options.apply(layer)) continue;
+        const int64_t count = layer->GetFeatureCount(FALSE);
+        total += MAX(count, int64_t(0));
+        const bool splittable = count > 0 && !options.has_feature_filters() && layer->TestCapability(OLCFastSetNextByIndex);
+        const int64_t parts = splittable ? MIN(int64_t(thread_count), (count + 4095) / 4096) : 1;
+        const int64_t per_part = splittable ? (count + parts - 1) / parts : -1;
+        for (int64_t p = 0; p < parts; ++p) {
+            Partition part;
+            part.layer = i;
+            part.first = splittable ? p * per_part : 0;
+            part.count = splittable ? MIN(per_part, count - p * per_part) : -1;
+            part.starts_layer = p == 0;
+            task->partitions.push_back(std::move(part));
+        }
+    }
+    GDALClose(ds);
+    task->features_expected = total;
+
+    if (!task->partitions.empty()) {
+        task->group_id = WorkerThreadPool::get_singleton()->add_group_task(
+                callable_mp(task.ptr(), &VectorLoadTask::_load_partition), int(task->partitions.size()), thread_count,
+                false, "VectorLoadTask");
+    }
+    return task;
+}
+
+void VectorLoadTask::_load_partition(uint32_t index) {
+    Partition &part = partitions[index];
+    GDALDataset *ds = (GDALDataset*) GDALOpenEx(real_path.c_str(), GDAL_OF_VECTOR, nullptr, nullptr, nullptr);
+    if (!ds) {
+        return;
+    }
+    OGRLayer *layer = ds->GetLayer(part.layer);
+    if (layer && options.apply(layer)) {
+        part.buffer.set_attribute_fields(options.selected_fields);
+        if (part.starts_layer) {
+            part.buffer.begin_layer(part.count);
+        }
+        part.buffer.bind_layer(layer->GetLayerDefn());
+        layer->ResetReading();
+        if (part.first > 0) {
+            layer->SetNextByIndex(part.first);
+        }
+        int64_t remaining = part.count;
+        OGRFeature *feat = nullptr;
+        while (remaining != 0 && !cancelled.load(std::memory_order_relaxed) && (feat = layer->GetNextFeature()) != nullptr) {
+            part.buffer.add_feature(feat);
+            OGRFeature::DestroyFeature(feat);
+            if (remaining > 0) --remaining;
+            features_read.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    GDALClose(ds);
+}
+
+bool VectorLoadTask::is_completed() const {
+    return waited || group_id < 0 || WorkerThreadPool::get_singleton()->is_group_task_completed(group_id);
+}
+
+float VectorLoadTask::get_progress() const {
+    if (is_completed()) return 1.0f;
+    if (features_expected <= 0) return 0.0f;
+    return MIN(1.0f, float(double(features_read.load()) / double(features_expected)));
+}
+
+void VectorLoadTask::cancel() {
+    cancelled.store(true);
+}
+
+void VectorLoadTask::wait() {
+    if (waited) return;
+    if (group_id >= 0) {
+        WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+    }
+    waited = true;
+}
+
+Dictionary VectorLoadTask::get_result() {
+    wait();
+    if (!merged) {
+        // Partitions are stored in layer / index order: appending them rebuilds the serial result
+        VectorGeometryBuffer merged_buffer;
+        merged_buffer.set_attribute_fields(options.selected_fields);
+        for (Partition &part : partitions) {
+            merged_buffer.append(part.buffer);
+            part.buffer = VectorGeometryBuffer();
+        }
+        result = merged_buffer.to_dictionary();
+        merged = true;
+    }
+    return result;
+}
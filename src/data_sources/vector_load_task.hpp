@@ -0,0 +1,62 @@
+#pragma once
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include "vector_geometry_buffer.hpp"
+#include "vector_load_options.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Background VectorSource::load_geometries. The layers are split into partitions (whole layers,
+// or feature index ranges when the driver supports a fast SetNextByIndex) read in parallel on
+// the WorkerThreadPool; each partition opens its own GDALDataset since datasets are not
+// thread-safe. get_result() merges the partitions in dataset order.
+// With a spatial or attribute filter, feature indices no longer match SetNextByIndex on every
+// driver, so filtered layers are read whole (one partition per layer).
+class VectorLoadTask : public godot::RefCounted {
+    GDCLASS(VectorLoadTask, godot::RefCounted);
+  public:
+    VectorLoadTask();
+    ~VectorLoadTask();
+
+    // `thread_count` <= 0: one partition per processor
+    static godot::Ref<VectorLoadTask> start(const godot::String &path, const VectorLoadOptions &options, int thread_count = 0);
+
+    bool is_completed() const;
+    // Features read so far / expected features (0..1, approximate when a driver cannot count)
+    float get_progress() const;
+    void cancel();
+    void wait();
+    // Same layout as VectorSource::load_geometries (waits for completion)
+    godot::Dictionary get_result();
+
+  protected:
+    static void _bind_methods();
+
+  private:
+    struct Partition {
+        int layer = 0;
+        int64_t first = 0;   // feature index
+        int64_t count = -1;  // -1: up to the end of the layer
+        bool starts_layer = true;
+        VectorGeometryBuffer buffer;
+    };
+
+    std::string real_path;
+    VectorLoadOptions options;
+    std::vector<Partition> partitions;
+    std::atomic<int64_t> features_read{0};
+    int64_t features_expected = 0;
+    std::atomic<bool> cancelled{false};
+    int64_t group_id = -1;
+    bool waited = false;
+    godot::Dictionary result;
+    bool merged = false;
+
+    void _load_partition(uint32_t index);
+};
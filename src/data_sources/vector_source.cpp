@@ -1,10 +1,12 @@
 #include "vector_source.hpp"
+#include "vector_geometry_buffer.hpp"
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/core/class_db.hpp> 
 #include <godot_cpp/variant/packed_vector2_array.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
 #include <gdal_priv.h>
 #include <ogrsf_frmts.h>
+#include <vector>
 using namespace godot;
 
 /*
@@ -14,30 +16,42 @@ case GDAL cannot open the resource directly. We can implement a fallback that op
 resource with FileAccess, loads bytes into memory and registers a /vsimem/ file for GDAL
 so it can read the dataset from memory.
 */
-Array VectorSource::load_paths(const String &path) {
-    Array out;
-
+static GDALDataset *open_vector_dataset(const String &path) {
     // Convert Godot resource path (res://, user://) to an absolute filesystem path
     String real_path = ProjectSettings::get_singleton()->globalize_path(path);
 
     GDALDataset *ds = (GDALDataset*) GDALOpenEx(real_path.utf8().get_data(), GDAL_OF_VECTOR, nullptr, nullptr, nullptr);
     if (!ds) {
         UtilityFunctions::printerr("GDALOpenEx failed: ", real_path);
+    }
+    return ds;
+}
+
+Array VectorSource::load_paths(const String &path) {
+    Array out;
+
+    GDALDataset *ds = open_vector_dataset(path);
+    if (!ds) {
         return out;
     }
+    std::vector<OGRRawPoint> points;
     for (int i = 0; i < ds->GetLayerCount(); ++i) {
         OGRLayer *layer = ds->GetLayer(i);
-        if (!layer) continue;
+        if (!layer || !options.apply(layer)) continue;
         layer->ResetReading();
         OGRFeature *feat = nullptr;
         while ((feat = layer->GetNextFeature()) != nullptr) {
             OGRGeometry *geom = feat->GetGeometryRef();
             if (geom && wkbFlatten(geom->getGeometryType()) == wkbLineString) {
                 auto *ls = geom->toLineString();
+                const int n = ls->getNumPoints();
+                points.resize(n);
+                ls->getPoints(points.data(), nullptr);
                 PackedVector2Array arr;
-                arr.resize(ls->getNumPoints());
-                for (int p = 0; p < ls->getNumPoints(); ++p) {
-                    arr.set(p, Vector2(ls->getX(p), ls->getY(p)));
+                arr.resize(n);
+                Vector2 *dst = arr.ptrw();
+                for (int p = 0; p < n; ++p) {
+                    dst[p] = Vector2(points[p].x, points[p].y);
                 }
                 out.push_back(arr);
             }
@@ -48,7 +62,90 @@ Array VectorSource::load_paths(const String &path) {
     return out;
 }
 
+Dictionary VectorSource::load_geometries(const String &path) {
+    GDALDataset *ds = open_vector_dataset(path);
+    if (!ds) {
+        return Dictionary();
+    }
+    VectorGeometryBuffer buffer;
+    buffer.set_attribute_fields(options.selected_fields);
+    for (int i = 0; i < ds->GetLayerCount(); ++i) {
+        OGRLayer *layer = ds->GetLayer(i);
+        if (!layer || !options.apply(layer)) continue;
+        // Only a hint for the reservation: cheap when the driver knows it, -1 otherwise
+        buffer.begin_layer(layer->GetFeatureCount(FALSE));
+        buffer.bind_layer(layer->GetLayerDefn());
+        layer->ResetReading();
+        OGRFeature *feat = nullptr;
+        while ((feat = layer->GetNextFeature()) != nullptr) {
+            buffer.add_feature(feat);
+            OGRFeature::DestroyFeature(feat);
+        }
+    }
+    GDALClose(ds);
+    return buffer.to_dictionary();
+}
+
+Ref<VectorLoadTask> VectorSource::load_geometries_async(const String &path, int thread_count) {
+    return VectorLoadTask::start(path, options, thread_count);
+}
+
+void VectorSource::set_spatial_filter(double min_x, double min_y, double max_x, double max_y) {
+    options.has_spatial_filter = true;
+    options.min_x = MIN(min_x, max_x);
+    options.min_y = MIN(min_y, max_y);
+    options.max_x = MAX(min_x, max_x);
+    options.max_y = MAX(min_y, max_y);
+}
+
+void VectorSource::clear_spatial_filter() {
+    options.has_spatial_filter = false;
+}
+
+PackedFloat64Array VectorSource::get_spatial_filter() const {
+    PackedFloat64Array res;
+    if (options.has_spatial_filter) {
+        res.push_back(options.min_x);
+        res.push_back(options.min_y);
+        res.push_back(options.max_x);
+        res.push_back(options.max_y);
+    }
+    return res;
+}
+
+void VectorSource::set_attribute_filter(const String &where) {
+    options.attribute_filter = where.utf8().get_data();
+}
+
+String VectorSource::get_attribute_filter() const {
+    return String::utf8(options.attribute_filter.c_str());
+}
+
+void VectorSource::set_selected_fields(const PackedStringArray &fields) {
+    options.selected_fields.clear();
+    for (int i = 0; i < fields.size(); ++i) {
+        options.selected_fields.push_back(fields[i].utf8().get_data());
+    }
+}
+
+PackedStringArray VectorSource::get_selected_fields() const {
+    PackedStringArray res;
+    for (const std::string &f : options.selected_fields) {
+        res.push_back(String::utf8(f.c_str()));
+    }
+    return res;
+}
+
 void VectorSource::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_spatial_filter", "min_x", "min_y", "max_x", "max_y"), &VectorSource::set_spatial_filter);
+    ClassDB::bind_method(D_METHOD("clear_spatial_filter"), &VectorSource::clear_spatial_filter);
+    ClassDB::bind_method(D_METHOD("get_spatial_filter"), &VectorSource::get_spatial_filter);
+    ClassDB::bind_method(D_METHOD("set_attribute_filter", "where"), &VectorSource::set_attribute_filter);
+    ClassDB::bind_method(D_METHOD("get_attribute_filter"), &VectorSource::get_attribute_filter);
+    ClassDB::bind_method(D_METHOD("set_selected_fields", "fields"), &VectorSource::set_selected_fields);
+    ClassDB::bind_method(D_METHOD("get_selected_fields"), &VectorSource::get_selected_fields);
+
     ClassDB::bind_method(D_METHOD("load_paths", "path"), &VectorSource::load_paths);
+    ClassDB::bind_method(D_METHOD("load_geometries", "path"), &VectorSource::load_geometries);
+    ClassDB::bind_method(D_METHOD("load_geometries_async", "path", "thread_count"), &VectorSource::load_geometries_async, DEFVAL(0));
 }
-
@@ -1,12 +1,39 @@
 #pragma once
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
 #include <godot_cpp/variant/packed_vector2_array.hpp>
 
+#include "vector_load_options.hpp"
+#include "vector_load_task.hpp"
+
 class VectorSource : public godot::RefCounted {
     GDCLASS(VectorSource, godot::RefCounted);
   public:
+    // Filters applied by every loader below (pushed down into OGR)
+    // Bounding box in the layer CRS: only features intersecting it are read
+    void set_spatial_filter(double min_x, double min_y, double max_x, double max_y);
+    void clear_spatial_filter();
+    // [min_x, min_y, max_x, max_y], empty when there is no spatial filter
+    godot::PackedFloat64Array get_spatial_filter() const;
+    // OGR SQL WHERE clause, e.g. "population > 10000"; empty to disable
+    void set_attribute_filter(const godot::String &where);
+    godot::String get_attribute_filter() const;
+    // Attribute fields returned by load_geometries ("attributes"); other fields are not decoded
+    void set_selected_fields(const godot::PackedStringArray &fields);
+    godot::PackedStringArray get_selected_fields() const;
+
+    // One PackedVector2Array per LineString feature
     godot::Array load_paths(const godot::String &path);
+    // Every feature of every layer, all geometry types, as flat packed arrays
+    // (layout documented in VectorGeometryBuffer)
+    godot::Dictionary load_geometries(const godot::String &path);
+    // Same result, read in the background by several workers (cf. VectorLoadTask)
+    godot::Ref<VectorLoadTask> load_geometries_async(const godot::String &path, int thread_count = 0);
   protected:
     static void _bind_methods();
+  private:
+    VectorLoadOptions options;
 };
@@ -0,0 +1,518 @@
+#include "vector_tiler.hpp"
+#include "line_simplifier.hpp"
+#include "vector_geometry_buffer.hpp"
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+
+#include <algorithm>
+#include <cmath>
+using namespace godot;
+
+namespace {
+
+constexpr int MAX_TILE_LOD = 28; // ix, iy on 28 bits in the cache key
+
+struct Rect {
+    double x0, y0, x1, y1;
+};
+
+// Tile features under construction (same layout as VectorGeometryBuffer, coords in lon / lat)
+struct TileWriter {
+    GrowablePacked<PackedFloat64Array, double> coords;
+    GrowablePacked<PackedInt32Array, int32_t> part_offsets;
+    GrowablePacked<PackedByteArray, uint8_t> part_kinds;
+    GrowablePacked<PackedInt32Array, int32_t> feature_offsets;
+    GrowablePacked<PackedByteArray, uint8_t> geometry_types;
+    GrowablePacked<PackedInt32Array, int32_t> source_features;
+
+    void add_part(uint8_t kind, const double *uv, int64_t count) {
+        part_offsets.push_back(int32_t(coords.size() / 2));
+        part_kinds.push_back(kind);
+        double *xy = coords.grow(count * 2);
+        for (int64_t i = 0; i < count; ++i) {
+            xy[i * 2] = uv[i * 2] * 360.0 - 180.0;
+            xy[i * 2 + 1] = 90.0 - uv[i * 2 + 1] * 180.0;
+        }
+    }
+
+    Dictionary to_dictionary() {
+        feature_offsets.push_back(int32_t(part_offsets.size()));
+        part_offsets.push_back(int32_t(coords.size() / 2));
+        Dictionary d;
+        d["coords"] = coords.finish();
+        d["part_offsets"] = part_offsets.finish();
+        d["part_kinds"] = part_kinds.finish();
+        d["feature_offsets"] = feature_offsets.finish();
+        d["geometry_types"] = geometry_types.finish();
+        d["source_features"] = source_features.finish();
+        return d;
+    }
+};
+
+// Liang–Barsky: visible parameter range [t0, t1] of the segment a -> b inside the rectangle
+bool clip_segment(const double *a, const double *b, const Rect &r, double &t0, double &t1) {
+    const double dx = b[0] - a[0];
+    const double dy = b[1] - a[1];
+    const double p[4] = { -dx, dx, -dy, dy };
+    const double q[4] = { a[0] - r.x0, r.x1 - a[0], a[1] - r.y0, r.y1 - a[1] };
+    t0 = 0.0;
+    t1 = 1.0;
+    for (int k = 0; k < 4; ++k) {
+        if (p[k] == 0.0) {
+            if (q[k] < 0.0) return false;
+        } else {
+            const double t = q[k] / p[k];
+            if (p[k] < 0.0) {
+                if (t > t1) return false;
+                t0 = MAX(t0, t);
+            } else {
+                if (t < t0) return false;
+                t1 = MIN(t1, t);
+            }
+        }
+    }
+    return true;
+}
+
+inline void push_lerp(std::vector<double> &out, const double *a, const double *b, double t) {
+    out.push_back(a[0] + (b[0] - a[0]) * t);
+    out.push_back(a[1] + (b[1] - a[1]) * t);
+}
+
+// One Sutherland–Hodgman pass: keeps the side of the line coord[axis] = value given by `keep_above`
+void clip_ring_edge(const std::vector<double> &in, std::vector<double> &out, int axis, double value, bool keep_above) {
+    out.clear();
+    const int64_t m = int64_t(in.size()) / 2;
+    for (int64_t i = 0; i < m; ++i) {
+        const double *cur = in.data() + i * 2;
+        const double *prev = in.data() + ((i + m - 1) % m) * 2;
+        const bool cur_in = keep_above ? cur[axis] >= value : cur[axis] <= value;
+        const bool prev_in = keep_above ? prev[axis] >= value : prev[axis] <= value;
+        if (cur_in != prev_in) {
+            const double t = (value - prev[axis]) / (cur[axis] - prev[axis]);
+            push_lerp(out, prev, cur, t);
+            out[out.size() - 2 + axis] = value;
+        }
+        if (cur_in) {
+            out.push_back(cur[0]);
+            out.push_back(cur[1]);
+        }
+    }
+}
+
+} // namespace
+
+VectorTiler::VectorTiler() {
+    index.instantiate();
+}
+
+VectorTiler::~VectorTiler() {
+    // Pool tasks point at this object and its cache entries
+    wait_all();
+}
+
+void VectorTiler::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_geometries", "geometries"), &VectorTiler::set_geometries);
+    ClassDB::bind_method(D_METHOD("get_feature_count"), &VectorTiler::get_feature_count);
+    ClassDB::bind_method(D_METHOD("set_extent", "extent"), &VectorTiler::set_extent);
+    ClassDB::bind_method(D_METHOD("get_extent"), &VectorTiler::get_extent);
+    ClassDB::bind_method(D_METHOD("set_tolerance", "tolerance"), &VectorTiler::set_tolerance);
+    ClassDB::bind_method(D_METHOD("get_tolerance"), &VectorTiler::get_tolerance);
+    ClassDB::bind_method(D_METHOD("set_buffer", "buffer"), &VectorTiler::set_buffer);
+    ClassDB::bind_method(D_METHOD("get_buffer"), &VectorTiler::get_buffer);
+    ClassDB::bind_method(D_METHOD("set_max_cached_tiles", "count"), &VectorTiler::set_max_cached_tiles);
+    ClassDB::bind_method(D_METHOD("get_max_cached_tiles"), &VectorTiler::get_max_cached_tiles);
+    ClassDB::bind_method(D_METHOD("build_tile", "lod", "ix", "iy"), &VectorTiler::build_tile);
+    ClassDB::bind_method(D_METHOD("request_tiles", "tiles"), &VectorTiler::request_tiles);
+    ClassDB::bind_method(D_METHOD("request_tile", "lod", "ix", "iy"), &VectorTiler::request_tile);
+    ClassDB::bind_method(D_METHOD("is_tile_ready", "lod", "ix", "iy"), &VectorTiler::is_tile_ready);
+    ClassDB::bind_method(D_METHOD("get_tile", "lod", "ix", "iy"), &VectorTiler::get_tile);
+    ClassDB::bind_method(D_METHOD("get_cached_tile_count"), &VectorTiler::get_cached_tile_count);
+    ClassDB::bind_method(D_METHOD("wait_all"), &VectorTiler::wait_all);
+    ClassDB::bind_method(D_METHOD("clear_cache"), &VectorTiler::clear_cache);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "extent"), "set_extent", "get_extent");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "tolerance"), "set_tolerance", "get_tolerance");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "buffer"), "set_buffer", "get_buffer");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_cached_tiles"), "set_max_cached_tiles", "get_max_cached_tiles");
+}
+
+Error VectorTiler::set_geometries(const Dictionary &geometries) {
+    clear_cache();
+    const PackedFloat64Array coords = geometries.get("coords", PackedFloat64Array());
+    part_offsets = geometries.get("part_offsets", PackedInt32Array());
+    part_kinds = geometries.get("part_kinds", PackedByteArray());
+    feature_offsets = geometries.get("feature_offsets", PackedInt32Array());
+    geometry_types = geometries.get("geometry_types", PackedByteArray());
+    if (feature_offsets.is_empty() || part_offsets.is_empty() || part_kinds.size() != part_offsets.size() - 1) {
+        uv = PackedFloat64Array();
+        importance = PackedFloat32Array();
+        part_offsets = PackedInt32Array();
+        feature_offsets = PackedInt32Array();
+        feature_sources = PackedInt32Array();
+        source_feature_count = 0;
+        index->reset(0);
+        index->finish();
+        ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Expected the output of VectorSource.load_geometries");
+    }
+
+    // Equirectangular unit square, the same as the terrain quadtree. Lines and rings are unwrapped
+    // (no step over 180° of longitude), so a feature crossing the antimeridian leaves [0, 1] in u:
+    // it is then stored a second time, shifted by one world width, as a feature of its own (own
+    // index box, same source feature), and each tile clips the copy it overlaps.
+    const double *src = coords.ptr();
+    const int32_t *src_parts = part_offsets.ptr();
+    const uint8_t *src_kinds = part_kinds.ptr();
+    const int32_t *src_features = feature_offsets.ptr();
+    const int64_t feature_count = feature_offsets.size() - 1;
+    GrowablePacked<PackedFloat64Array, double> out_uv;
+    GrowablePacked<PackedInt32Array, int32_t> out_parts;
+    GrowablePacked<PackedByteArray, uint8_t> out_kinds;
+    GrowablePacked<PackedInt32Array, int32_t> out_features;
+    GrowablePacked<PackedInt32Array, int32_t> out_sources;
+    out_uv.reserve(coords.size());
+    out_parts.reserve(part_offsets.size());
+    out_kinds.reserve(part_kinds.size());
+    out_features.reserve(feature_offsets.size());
+    out_sources.reserve(feature_count);
+
+    for (int64_t f = 0; f < feature_count; ++f) {
+        out_features.push_back(int32_t(out_parts.size()));
+        out_sources.push_back(int32_t(f));
+        const int64_t first_vertex = out_uv.size() / 2;
+        const int64_t first_part = out_parts.size();
+        double min_u = 0.0, max_u = 1.0;
+        bool skip_holes = false;
+        for (int32_t p = src_features[f]; p < src_features[f + 1]; ++p) {
+            const uint8_t kind = src_kinds[p];
+            if (kind == VectorGeometryBuffer::PART_INTERIOR_RING && skip_holes) {
+                continue;
+            }
+            if (kind == VectorGeometryBuffer::PART_EXTERIOR_RING) {
+                skip_holes = false;
+            }
+            const int64_t n = src_parts[p + 1] - src_parts[p];
+            const double *ll = src + int64_t(src_parts[p]) * 2;
+            const bool connected = kind != VectorGeometryBuffer::PART_POINTS;
+            const int64_t part_vertex = out_uv.size() / 2;
+            double *dst = out_uv.grow(n * 2);
+            double part_min_u = 0.0, part_max_u = 1.0;
+            for (int64_t i = 0; i < n; ++i) {
+                double u = (ll[i * 2] + 180.0) / 360.0;
+                if (connected && i > 0) {
+                    u += std::round(dst[(i - 1) * 2] - u);
+                }
+                dst[i * 2] = u;
+                dst[i * 2 + 1] = (90.0 - ll[i * 2 + 1]) / 180.0;
+                part_min_u = MIN(part_min_u, u);
+                part_max_u = MAX(part_max_u, u);
+            }
+            // A ring around a pole winds once around the world: unwrapped, it does not close
+            const bool ring = kind == VectorGeometryBuffer::PART_EXTERIOR_RING || kind == VectorGeometryBuffer::PART_INTERIOR_RING;
+            if (ring && n > 1 && std::abs(dst[(n - 1) * 2] - dst[0]) > 0.5) {
+                ERR_PRINT(String("Feature ") + String::num_int64(f) + ": ring enclosing a pole, polygon skipped.");
+                out_uv.truncate(part_vertex * 2);
+                skip_holes = kind == VectorGeometryBuffer::PART_EXTERIOR_RING;
+                continue;
+            }
+            out_parts.push_back(int32_t(part_vertex));
+            out_kinds.push_back(kind);
+            min_u = MIN(min_u, part_min_u);
+            max_u = MAX(max_u, part_max_u);
+        }
+        // Copies on the other side of the antimeridian, with the exterior ring still before its holes
+        const int64_t part_end = out_parts.size();
+        const int64_t vertex_end = out_uv.size() / 2;
+        for (const double shift : { 1.0, -1.0 }) {
+            if ((shift > 0.0 && min_u >= 0.0) || (shift < 0.0 && max_u <= 1.0)) {
+                continue;
+            }
+            out_features.push_back(int32_t(out_parts.size()));
+            out_sources.push_back(int32_t(f));
+            const int64_t base = out_uv.size() / 2;
+            for (int64_t p = first_part; p < part_end; ++p) {
+                out_parts.push_back(int32_t(base + out_parts[p] - first_vertex));
+                out_kinds.push_back(out_kinds[p]);
+            }
+            double *dst = out_uv.grow((vertex_end - first_vertex) * 2);
+            const double *copy = out_uv.ptr() + first_vertex * 2;
+            for (int64_t i = 0; i < vertex_end - first_vertex; ++i) {
+                dst[i * 2] = copy[i * 2] + shift;
+                dst[i * 2 + 1] = copy[i * 2 + 1];
+            }
+        }
+    }
+    out_parts.push_back(int32_t(out_uv.size() / 2));
+    out_features.push_back(int32_t(out_kinds.size()));
+    uv = out_uv.finish();
+    part_offsets = out_parts.finish();
+    part_kinds = out_kinds.finish();
+    feature_offsets = out_features.finish();
+    feature_sources = out_sources.finish();
+    source_feature_count = int(feature_count);
+
+    Dictionary projected;
+    projected["coords"] = uv;
+    projected["part_offsets"] = part_offsets;
+    projected["part_kinds"] = part_kinds;
+    projected["feature_offsets"] = feature_offsets;
+    // Simplification is precomputed once for every tile (in unit square distances)
+    importance = LineSimplifier::compute_importance(projected);
+    return index->build_from_geometries(projected);
+}
+
+int VectorTiler::get_feature_count() const {
+    return source_feature_count;
+}
+
+void VectorTiler::set_extent(int p_extent) {
+    ERR_FAIL_COND(p_extent < 1);
+    clear_cache();
+    extent = p_extent;
+}
+
+void VectorTiler::set_tolerance(double p_tolerance) {
+    clear_cache();
+    tolerance = MAX(p_tolerance, 0.0);
+}
+
+void VectorTiler::set_buffer(int p_buffer) {
+    clear_cache();
+    buffer = MAX(p_buffer, 0);
+}
+
+void VectorTiler::set_max_cached_tiles(int count) {
+    max_cached_tiles = MAX(count, 1);
+    evict();
+}
+
+uint64_t VectorTiler::make_key(int lod, int ix, int iy) {
+    return (uint64_t(lod) << 56) | (uint64_t(uint32_t(ix)) << 28) | uint64_t(uint32_t(iy));
+}
+
+Dictionary VectorTiler::build_tile(int lod, int ix, int iy) const {
+    TileWriter writer;
+    ERR_FAIL_INDEX_V(lod, MAX_TILE_LOD + 1, writer.to_dictionary());
+    const int64_t tiles = int64_t(1) << lod;
+    ERR_FAIL_COND_V(ix < 0 || iy < 0 || ix >= tiles || iy >= tiles, writer.to_dictionary());
+    if (get_feature_count() == 0) {
+        return writer.to_dictionary();
+    }
+
+    const double size = 1.0 / double(tiles);
+    const double pad = size * buffer / extent;
+    const Rect rect = { ix * size - pad, iy * size - pad, (ix + 1) * size + pad, (iy + 1) * size + pad };
+    const double tol = size * tolerance / extent;
+
+    PackedInt32Array found = index->search(rect.x0, rect.y0, rect.x1, rect.y1);
+    std::sort(found.ptrw(), found.ptrw() + found.size());
+
+    const double *pts = uv.ptr();
+    const float *imp = importance.ptr();
+    const int32_t *parts = part_offsets.ptr();
+    const uint8_t *kinds = part_kinds.ptr();
+    const int32_t *features = feature_offsets.ptr();
+    const int32_t *sources = feature_sources.ptr();
+    std::vector<double> kept, scratch, other;
+    int32_t last_source = -1;
+
+    for (int64_t k = 0; k < found.size(); ++k) {
+        const int32_t f = found[k];
+        const int32_t source = sources[f];
+        const int64_t first_part = writer.part_offsets.size();
+        bool exterior_kept = true;
+
+        for (int32_t p = features[f]; p < features[f + 1]; ++p) {
+            const uint8_t kind = kinds[p];
+            const double *v = pts + int64_t(parts[p]) * 2;
+            int64_t n = parts[p + 1] - parts[p];
+            if (kind == VectorGeometryBuffer::PART_INTERIOR_RING && !exterior_kept) {
+                continue; // the hole of a polygon already clipped away
+            }
+
+            double bx0 = v[0], by0 = v[1], bx1 = v[0], by1 = v[1];
+            for (int64_t i = 1; i < n; ++i) {
+                bx0 = MIN(bx0, v[i * 2]);
+                by0 = MIN(by0, v[i * 2 + 1]);
+                bx1 = MAX(bx1, v[i * 2]);
+                by1 = MAX(by1, v[i * 2 + 1]);
+            }
+            const bool outside = n == 0 || bx1 < rect.x0 || by1 < rect.y0 || bx0 > rect.x1 || by0 > rect.y1;
+            const bool inside = bx0 >= rect.x0 && by0 >= rect.y0 && bx1 <= rect.x1 && by1 <= rect.y1;
+
+            switch (kind) {
+                case VectorGeometryBuffer::PART_POINTS: {
+                    if (outside) break;
+                    scratch.clear();
+                    for (int64_t i = 0; i < n; ++i) {
+                        const double *q = v + i * 2;
+                        if (inside || (q[0] >= rect.x0 && q[0] <= rect.x1 && q[1] >= rect.y0 && q[1] <= rect.y1)) {
+                            scratch.push_back(q[0]);
+                            scratch.push_back(q[1]);
+                        }
+                    }
+                    if (!scratch.empty()) {
+                        writer.add_part(kind, scratch.data(), int64_t(scratch.size()) / 2);
+                    }
+                } break;
+
+                case VectorGeometryBuffer::PART_LINE: {
+                    if (outside || n < 2) break;
+                    // Simplified before clipping: neighbouring tiles cut the same line
+                    kept.resize(size_t(n) * 2);
+                    n = LineSimplifier::select(v, imp + parts[p], n, tol, kept.data());
+                    v = kept.data();
+                    if (inside) {
+                        writer.add_part(kind, v, n);
+                        break;
+                    }
+                    // A line leaving the tile and coming back gives several parts
+                    scratch.clear();
+                    for (int64_t i = 0; i + 1 < n; ++i) {
+                        const double *a = v + i * 2;
+                        const double *b = a + 2;
+                        double t0, t1;
+                        if (!clip_segment(a, b, rect, t0, t1)) {
+                            continue;
+                        }
+                        if (scratch.empty()) {
+                            push_lerp(scratch, a, b, t0);
+                        }
+                        push_lerp(scratch, a, b, t1);
+                        if (t1 < 1.0 || i + 2 == n) {
+                            writer.add_part(kind, scratch.data(), int64_t(scratch.size()) / 2);
+                            scratch.clear();
+                        }
+                    }
+                } break;
+
+                case VectorGeometryBuffer::PART_EXTERIOR_RING:
+                case VectorGeometryBuffer::PART_INTERIOR_RING: {
+                    const bool exterior = kind == VectorGeometryBuffer::PART_EXTERIOR_RING;
+                    if (exterior) exterior_kept = false;
+                    if (outside || n < 4) break;
+                    kept.resize(size_t(n) * 2);
+                    n = LineSimplifier::select(v, imp + parts[p], n, tol, kept.data());
+                    v = kept.data();
+                    if (n < 4) break; // collapsed below a triangle at this level
+                    if (inside) {
+                        scratch.assign(v, v + n * 2);
+                    } else {
+                        // Open ring through the four edges, then closed again
+                        scratch.assign(v, v + (n - 1) * 2);
+                        clip_ring_edge(scratch, other, 0, rect.x0, true);
+                        clip_ring_edge(other, scratch, 0, rect.x1, false);
+                        clip_ring_edge(scratch, other, 1, rect.y0, true);
+                        clip_ring_edge(other, scratch, 1, rect.y1, false);
+                        if (scratch.size() < 6) break;
+                        scratch.push_back(scratch[0]);
+                        scratch.push_back(scratch[1]);
+                    }
+                    writer.add_part(kind, scratch.data(), int64_t(scratch.size()) / 2);
+                    if (exterior) exterior_kept = true;
+                } break;
+            }
+        }
+
+        // Both copies of a feature in the same tile (sorted, so adjacent) form a single tile feature
+        if (writer.part_offsets.size() > first_part && source != last_source) {
+            writer.feature_offsets.push_back(int32_t(first_part));
+            writer.geometry_types.push_back(source < geometry_types.size() ? geometry_types[source] : 0);
+            writer.source_features.push_back(source);
+            last_source = source;
+        }
+    }
+    return writer.to_dictionary();
+}
+
+void VectorTiler::_build_entry(int64_t entry_ptr) {
+    // Worker thread: reads the source arrays, which do not change while tasks are pending
+    TileEntry *entry = reinterpret_cast<TileEntry *>(entry_ptr);
+    entry->result = build_tile(entry->lod, entry->ix, entry->iy);
+}
+
+bool VectorTiler::complete(TileEntry &entry, bool block) {
+    if (entry.waited) return true;
+    if (!block && !WorkerThreadPool::get_singleton()->is_task_completed(entry.task_id)) {
+        return false;
+    }
+    WorkerThreadPool::get_singleton()->wait_for_task_completion(entry.task_id);
+    entry.waited = true;
+    return true;
+}
+
+bool VectorTiler::request_tile(int lod, int ix, int iy) {
+    ERR_FAIL_INDEX_V(lod, MAX_TILE_LOD + 1, false);
+    const int64_t tiles = int64_t(1) << lod;
+    ERR_FAIL_COND_V(ix < 0 || iy < 0 || ix >= tiles || iy >= tiles, false);
+
+    const uint64_t key = make_key(lod, ix, iy);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        it->second->last_used = ++use_counter;
+        return false;
+    }
+    std::unique_ptr<TileEntry> entry = std::make_unique<TileEntry>();
+    entry->lod = lod;
+    entry->ix = ix;
+    entry->iy = iy;
+    entry->last_used = ++use_counter;
+    entry->task_id = WorkerThreadPool::get_singleton()->add_task(
+            callable_mp(this, &VectorTiler::_build_entry).bind(int64_t(reinterpret_cast<intptr_t>(entry.get()))),
+            false, "VectorTiler");
+    cache.emplace(key, std::move(entry));
+    evict();
+    return true;
+}
+
+int VectorTiler::request_tiles(const Array &tiles) {
+    int queued = 0;
+    for (int64_t i = 0; i < tiles.size(); ++i) {
+        const Dictionary t = tiles[i];
+        if (request_tile(int(t.get("lod", 0)), int(t.get("ix", 0)), int(t.get("iy", 0)))) {
+            ++queued;
+        }
+    }
+    return queued;
+}
+
+bool VectorTiler::is_tile_ready(int lod, int ix, int iy) {
+    auto it = cache.find(make_key(lod, ix, iy));
+    return it != cache.end() && complete(*it->second, false);
+}
+
+Dictionary VectorTiler::get_tile(int lod, int ix, int iy) {
+    auto it = cache.find(make_key(lod, ix, iy));
+    if (it == cache.end() || !complete(*it->second, false)) {
+        return Dictionary();
+    }
+    it->second->last_used = ++use_counter;
+    return it->second->result;
+}
+
+void VectorTiler::evict() {
+    // Least recently used first; tiles still being built stay
+    while (int(cache.size()) > max_cached_tiles) {
+        auto oldest = cache.end();
+        for (auto it = cache.begin(); it != cache.end(); ++it) {
+            if ((oldest == cache.end() || it->second->last_used < oldest->second->last_used) && complete(*it->second, false)) {
+                oldest = it;
+            }
+        }
+        if (oldest == cache.end()) {
+            break;
+        }
+        cache.erase(oldest);
+    }
+}
+
+void VectorTiler::wait_all() {
+    for (auto &kv : cache) {
+        complete(*kv.second, true);
+    }
+}
+
+void VectorTiler::clear_cache() {
+    wait_all();
+    cache.clear();
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+
+#include "spatial_index.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Cuts a VectorSource::load_geometries result (lon / lat degrees) into QuadtreeCPU tiles, the
+// way geojson-vt does: the tile (lod, ix, iy) covers [ix, ix + 1] x [iy, iy + 1] / 2^lod of the
+// equirectangular unit square (u = (lon + 180) / 360, v = (90 - lat) / 180, north at v = 0).
+// Each tile keeps the features intersecting it (SpatialIndex lookup), clipped to the tile plus
+// `buffer` and simplified to `tolerance`, both in 1 / `extent` of the tile. Simplification uses
+// Douglas–Peucker importance computed once in set_geometries (cf. LineSimplifier).
+// Lines and rings crossing ±180° are unwrapped and also stored shifted by one world width (a
+// separate index entry), so both sides of the antimeridian get their share; rings enclosing a
+// pole are not supported and their polygon is skipped with an error.
+// Tiles are built on the WorkerThreadPool (request_tiles) and cached (LRU, max_cached_tiles);
+// get_tile returns them once ready. Every method must be called from the same thread.
+//
+// Tile layout: "coords", "part_offsets", "part_kinds", "feature_offsets", "geometry_types" as in
+// VectorGeometryBuffer (coords in lon / lat), plus "source_features" (PackedInt32Array), the
+// index of each tile feature in the source dictionary (attributes, fids…).
+class VectorTiler : public godot::RefCounted {
+    GDCLASS(VectorTiler, godot::RefCounted);
+  public:
+    VectorTiler();
+    ~VectorTiler();
+
+    // Replaces the source data and drops the cache
+    godot::Error set_geometries(const godot::Dictionary &geometries);
+    int get_feature_count() const;
+
+    void set_extent(int extent);
+    int get_extent() const { return extent; }
+    void set_tolerance(double tolerance);
+    double get_tolerance() const { return tolerance; }
+    void set_buffer(int buffer);
+    int get_buffer() const { return buffer; }
+    void set_max_cached_tiles(int count);
+    int get_max_cached_tiles() const { return max_cached_tiles; }
+
+    // Synchronous, bypasses the cache
+    godot::Dictionary build_tile(int lod, int ix, int iy) const;
+
+    // Queues the missing tiles of a QuadtreeCPU::build_tile_list result; returns how many were queued
+    int request_tiles(const godot::Array &tiles);
+    // True when the tile was not cached yet and has been queued
+    bool request_tile(int lod, int ix, int iy);
+    bool is_tile_ready(int lod, int ix, int iy);
+    // Empty dictionary while the tile is not built (or not requested)
+    godot::Dictionary get_tile(int lod, int ix, int iy);
+    int get_cached_tile_count() const { return int(cache.size()); }
+    void wait_all();
+    void clear_cache();
+
+  protected:
+    static void _bind_methods();
+
+  private:
+    struct TileEntry {
+        int lod = 0, ix = 0, iy = 0;
+        int64_t task_id = -1;
+        bool waited = false;
+        uint64_t last_used = 0;
+        godot::Dictionary result;
+    };
+
+    // Source, projected to the unit square
+    godot::PackedFloat64Array uv;
+    godot::PackedFloat32Array importance;
+    godot::PackedInt32Array part_offsets;
+    godot::PackedByteArray part_kinds;
+    godot::PackedInt32Array feature_offsets;
+    // Source feature of each stored feature: antimeridian copies share the source of the original
+    godot::PackedInt32Array feature_sources;
+    int source_feature_count = 0;
+    godot::PackedByteArray geometry_types;
+    godot::Ref<SpatialIndex> index;
+
+    int extent = 4096;
+    double tolerance = 3.0;
+    int buffer = 64;
+    int max_cached_tiles = 256;
+
+    std::unordered_map<uint64_t, std::unique_ptr<TileEntry>> cache;
+    uint64_t use_counter = 0;
+
+    static uint64_t make_key(int lod, int ix, int iy);
+    // Finishes the pool task of `entry` if it is done (or `block`), returns whether it is ready
+    bool complete(TileEntry &entry, bool block);
+    void evict();
+    void _build_entry(int64_t entry_ptr);
+};
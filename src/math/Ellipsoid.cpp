@@ -1,4 +1,5 @@
 #include "Ellipsoid.hpp"
+#include "ParallelFor.hpp"
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/variant/packed_vector3_array.hpp>
 #include <godot_cpp/classes/rendering_server.hpp>
@@ -22,9 +23,22 @@ void Ellipsoid::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get_minimum_radius"), &Ellipsoid::get_minimum_radius);
     ClassDB::bind_method(D_METHOD("get_maximum_radius"), &Ellipsoid::get_maximum_radius);
     ClassDB::bind_method(D_METHOD("geodetic_to_3d", "latitude_deg", "longitude_deg", "altitude"), &Ellipsoid::geodetic_to_3d);
+    ClassDB::bind_method(D_METHOD("geodetic_to_3d_f64", "latitude_deg", "longitude_deg", "altitude"), &Ellipsoid::geodetic_to_3d_f64);
+    ClassDB::bind_method(D_METHOD("geodetic_to_3d_array", "latitudes_deg", "longitudes_deg", "altitudes"), &Ellipsoid::geodetic_to_3d_array, DEFVAL(PackedFloat64Array()));
+    ClassDB::bind_method(D_METHOD("geodetic_to_3d_vector3_array", "lat_lon_alt"), &Ellipsoid::geodetic_to_3d_vector3_array);
+    ClassDB::bind_method(D_METHOD("get_eccentricity_squared"), &Ellipsoid::get_eccentricity_squared);
+    ClassDB::bind_method(D_METHOD("cartesian_to_geodetic", "position"), &Ellipsoid::cartesian_to_geodetic);
+    ClassDB::bind_method(D_METHOD("cartesian_to_geodetic_f64", "x", "y", "z"), &Ellipsoid::cartesian_to_geodetic_f64);
+    ClassDB::bind_method(D_METHOD("cartesian_to_geodetic_array", "xyz"), &Ellipsoid::cartesian_to_geodetic_array);
+    ClassDB::bind_method(D_METHOD("cartesian_to_geodetic_vector3_array", "positions"), &Ellipsoid::cartesian_to_geodetic_vector3_array);
     ClassDB::bind_method(D_METHOD("scale_to_geodetic_surface", "p"), &Ellipsoid::scale_to_geodetic_surface);
     ClassDB::bind_method(D_METHOD("intersections", "origin", "direction"), &Ellipsoid::intersections);
+    ClassDB::bind_method(D_METHOD("intersect_rays", "origins", "directions"), &Ellipsoid::intersect_rays);
     ClassDB::bind_method(D_METHOD("centric_surface_normal", "position"), &Ellipsoid::centric_surface_normal);
+    ClassDB::bind_method(D_METHOD("get_cartesian_radii"), &Ellipsoid::get_cartesian_radii);
+    ClassDB::bind_method(D_METHOD("compute_horizon_culling_point", "direction_to_point", "positions"), &Ellipsoid::compute_horizon_culling_point);
+    ClassDB::bind_method(D_METHOD("is_occluder_point_visible", "camera_position", "occluder_point"), &Ellipsoid::is_occluder_point_visible);
+    ClassDB::bind_method(D_METHOD("are_occluder_points_visible", "camera_position", "occluder_points"), &Ellipsoid::are_occluder_points_visible);
 
     ADD_PROPERTY(PropertyInfo(Variant::VECTOR3, "axis", PROPERTY_HINT_NONE, "Ellipsoid axes (meters): X=equatorial, Y=equatorial, Z=pole. Set before adding to scene to avoid default overwrite."), "set_axis", "get_axis");
 
@@ -50,6 +64,13 @@ void Ellipsoid::set_axis(const Vector3 &axis) {
     _axis_squared = Vector3(axis.x * axis.x, axis.y * axis.y, axis.z * axis.z);
     _axis_to_the_fourth = Vector3(_axis_squared.x * _axis_squared.x, _axis_squared.y * _axis_squared.y, _axis_squared.z * _axis_squared.z);
     _one_over_axis_squared = Vector3(1.0 / _axis_squared.x, 1.0 / _axis_squared.y, 1.0 / _axis_squared.z);
+    // geodetic_to_3d puts the polar axis (axis.z) on Y and the second equatorial axis on Z
+    _cartesian_radii = Vector3(axis.x, axis.z, axis.y);
+    _one_over_cartesian_radii = Vector3(1.0 / _cartesian_radii.x, 1.0 / _cartesian_radii.y, 1.0 / _cartesian_radii.z);
+    _cartesian_radii_squared = Vector3(_axis_squared.x, _axis_squared.z, _axis_squared.y);
+    _cartesian_radii_to_the_fourth = Vector3(_axis_to_the_fourth.x, _axis_to_the_fourth.z, _axis_to_the_fourth.y);
+    _one_over_cartesian_radii_squared = Vector3(_one_over_axis_squared.x, _one_over_axis_squared.z, _one_over_axis_squared.y);
+    _e2 = 1.0 - (double(axis.z) * axis.z) / (double(axis.x) * axis.x);
 }
 
 Vector3 Ellipsoid::get_axis() const {
@@ -70,8 +91,7 @@ Vector3 Ellipsoid::geodetic_to_3d(real_t latitude_deg, real_t longitude_deg, rea
     real_t rad_lon = Math::deg_to_rad(longitude_deg) - Math_PI/2.0;
 
     real_t a = _axis.x;
-    real_t b = _axis.z;
-    real_t e2 = 1.0 - (b * b) / (a * a);
+    real_t e2 = _e2;
 
     real_t N = a / std::sqrt(1.0 - e2 * std::sin(rad_lat) * std::sin(rad_lat));
 
@@ -83,14 +103,209 @@ Vector3 Ellipsoid::geodetic_to_3d(real_t latitude_deg, real_t longitude_deg, rea
     return cartesian_coord;
 }
 
+void Ellipsoid::geodetic_to_3d_double(double latitude_deg, double longitude_deg, double altitude, double r_xyz[3]) const {
+    const double rad_lat = Math::deg_to_rad(latitude_deg);
+    const double rad_lon = Math::deg_to_rad(longitude_deg) - Math_PI / 2.0;
+
+    const double a = _axis.x;
+    const double e2 = _e2;
+
+    const double sin_lat = std::sin(rad_lat);
+    const double cos_lat = std::cos(rad_lat);
+    const double N = a / std::sqrt(1.0 - e2 * sin_lat * sin_lat);
+
+    r_xyz[0] = (N + altitude) * cos_lat * std::cos(rad_lon);
+    r_xyz[1] = ((N * (1.0 - e2)) + altitude) * sin_lat;
+    r_xyz[2] = (N + altitude) * cos_lat * std::sin(rad_lon);
+}
+
+PackedFloat64Array Ellipsoid::geodetic_to_3d_f64(double latitude_deg, double longitude_deg, double altitude) const {
+    PackedFloat64Array res;
+    res.resize(3);
+    geodetic_to_3d_double(latitude_deg, longitude_deg, altitude, res.ptrw());
+    return res;
+}
+
+namespace {
+
+constexpr int64_t GEODETIC_BATCH_GRAIN = 4096;
+
+// Same formula as geodetic_to_3d_double; sin/cos of the same angle are fused into sincos by the compiler
+inline void geodetic_point(double a, double e2, double lat_deg, double lon_deg, double alt, double *r_xyz) {
+    const double rad_lat = lat_deg * (Math_PI / 180.0);
+    const double rad_lon = lon_deg * (Math_PI / 180.0) - Math_PI / 2.0;
+    const double sin_lat = std::sin(rad_lat), cos_lat = std::cos(rad_lat);
+    const double sin_lon = std::sin(rad_lon), cos_lon = std::cos(rad_lon);
+    const double N = a / std::sqrt(1.0 - e2 * sin_lat * sin_lat);
+    const double r = (N + alt) * cos_lat;
+    r_xyz[0] = r * cos_lon;
+    r_xyz[1] = (N * (1.0 - e2) + alt) * sin_lat;
+    r_xyz[2] = r * sin_lon;
+}
+
+// Inverse of geodetic_point. Same frame: polar axis on y, lon' = lon - 90° measured from x towards z.
+// Vermeille, "An analytical method to transform geocentric into geodetic coordinates" (2011).
+inline void geodetic_from_point(double a, double e2, double x, double y, double z, double *r_lla) {
+    const double rho2 = x * x + z * z;
+    const double rho = std::sqrt(rho2);
+    const double e4 = e2 * e2;
+    const double inv_a2 = 1.0 / (a * a);
+
+    const double p = rho2 * inv_a2;
+    const double q = (1.0 - e2) * y * y * inv_a2;
+    const double r = (p + q - e4) / 6.0;
+    const double evolute = 8.0 * r * r * r + e4 * p * q;
+
+    double lat, alt;
+    if (evolute > 0.0) {
+        // Outside the evolute: everything but a disc of radius ~e² a (43 km for WGS84) around the centre
+        const double right = std::sqrt(e4 * p * q);
+        const double sqrt_evolute = std::sqrt(evolute);
+        const double u = r + 0.5 * std::cbrt((sqrt_evolute + right) * (sqrt_evolute + right))
+                           + 0.5 * std::cbrt((sqrt_evolute - right) * (sqrt_evolute - right));
+        const double v = std::sqrt(u * u + e4 * q);
+        const double w = e2 * (u + v - q) / (2.0 * v);
+        const double k = (u + v) / (std::sqrt(w * w + u + v) + w);
+        const double d = k * rho / (k + e2);
+        const double dz = std::sqrt(d * d + y * y);
+        lat = 2.0 * std::atan2(y, dz + d);
+        alt = (k + e2 - 1.0) / k * dz;
+    } else {
+        // Near the centre: Bowring's iteration on the reduced latitude, converged well before the bound
+        const double b = a * std::sqrt(1.0 - e2);
+        const double ep2 = e2 / (1.0 - e2);
+        double beta = std::atan2(a * y, b * rho);
+        lat = 0.0;
+        for (int i = 0; i < 8; ++i) {
+            const double sb = std::sin(beta), cb = std::cos(beta);
+            lat = std::atan2(y + ep2 * b * sb * sb * sb, rho - e2 * a * cb * cb * cb);
+            beta = std::atan2(b * std::sin(lat), a * std::cos(lat));
+        }
+        const double sl = std::sin(lat);
+        alt = rho * std::cos(lat) + y * sl - a * std::sqrt(1.0 - e2 * sl * sl);
+    }
+
+    double lon = std::atan2(z, x) * (180.0 / Math_PI) + 90.0;
+    if (lon > 180.0) {
+        lon -= 360.0;
+    }
+    r_lla[0] = lat * (180.0 / Math_PI);
+    r_lla[1] = lon;
+    r_lla[2] = alt;
+}
+
+} // namespace
+
+void Ellipsoid::cartesian_to_geodetic_batch(double a, double e2, const double *xyz, int64_t count, double *r_lat_lon_alt) {
+    for (int64_t i = 0; i < count; ++i) {
+        geodetic_from_point(a, e2, xyz[i * 3], xyz[i * 3 + 1], xyz[i * 3 + 2], r_lat_lon_alt + i * 3);
+    }
+}
+
+void Ellipsoid::cartesian_to_geodetic_double(double x, double y, double z, double r_lat_lon_alt[3]) const {
+    geodetic_from_point(_axis.x, _e2, x, y, z, r_lat_lon_alt);
+}
+
+Vector3 Ellipsoid::cartesian_to_geodetic(const Vector3 &position) const {
+    double lla[3];
+    cartesian_to_geodetic_double(position.x, position.y, position.z, lla);
+    return Vector3(lla[0], lla[1], lla[2]);
+}
+
+PackedFloat64Array Ellipsoid::cartesian_to_geodetic_f64(double x, double y, double z) const {
+    PackedFloat64Array res;
+    res.resize(3);
+    cartesian_to_geodetic_double(x, y, z, res.ptrw());
+    return res;
+}
+
+PackedFloat64Array Ellipsoid::cartesian_to_geodetic_array(const PackedFloat64Array &xyz) const {
+    ERR_FAIL_COND_V_MSG(xyz.size() % 3 != 0, PackedFloat64Array(), "xyz must hold x, y, z triplets.");
+    const int64_t count = xyz.size() / 3;
+
+    PackedFloat64Array res;
+    res.resize(count * 3);
+    const double *in = xyz.ptr();
+    double *out = res.ptrw();
+    const double a = _axis.x, e2 = _e2;
+
+    parallel_for(count, GEODETIC_BATCH_GRAIN, [&](int64_t begin, int64_t end) {
+        cartesian_to_geodetic_batch(a, e2, in + begin * 3, end - begin, out + begin * 3);
+    });
+    return res;
+}
+
+PackedVector3Array Ellipsoid::cartesian_to_geodetic_vector3_array(const PackedVector3Array &positions) const {
+    const int64_t count = positions.size();
+    PackedVector3Array res;
+    res.resize(count);
+    const Vector3 *in = positions.ptr();
+    Vector3 *out = res.ptrw();
+    const double a = _axis.x, e2 = _e2;
+
+    parallel_for(count, GEODETIC_BATCH_GRAIN, [&](int64_t begin, int64_t end) {
+        double lla[3];
+        for (int64_t i = begin; i < end; ++i) {
+            geodetic_from_point(a, e2, in[i].x, in[i].y, in[i].z, lla);
+            out[i] = Vector3(lla[0], lla[1], lla[2]);
+        }
+    });
+    return res;
+}
+
+void Ellipsoid::geodetic_to_3d_batch(double a, double e2, const double *lat_deg, const double *lon_deg, const double *alt,
+                                     int64_t count, double *r_xyz) {
+    for (int64_t i = 0; i < count; ++i) {
+        geodetic_point(a, e2, lat_deg[i], lon_deg[i], alt ? alt[i] : 0.0, r_xyz + i * 3);
+    }
+}
+
+PackedFloat64Array Ellipsoid::geodetic_to_3d_array(const PackedFloat64Array &latitudes_deg, const PackedFloat64Array &longitudes_deg, const PackedFloat64Array &altitudes) const {
+    const int64_t count = latitudes_deg.size();
+    ERR_FAIL_COND_V_MSG(longitudes_deg.size() != count, PackedFloat64Array(), "latitudes and longitudes must have the same size.");
+    ERR_FAIL_COND_V_MSG(!altitudes.is_empty() && altitudes.size() != count, PackedFloat64Array(), "altitudes must be empty or match the latitudes.");
+
+    PackedFloat64Array res;
+    res.resize(count * 3);
+    const double *lat = latitudes_deg.ptr();
+    const double *lon = longitudes_deg.ptr();
+    const double *alt = altitudes.is_empty() ? nullptr : altitudes.ptr();
+    double *out = res.ptrw();
+    const double a = _axis.x, e2 = _e2;
+
+    parallel_for(count, GEODETIC_BATCH_GRAIN, [&](int64_t begin, int64_t end) {
+        geodetic_to_3d_batch(a, e2, lat + begin, lon + begin, alt ? alt + begin : nullptr, end - begin, out + begin * 3);
+    });
+    return res;
+}
+
+PackedVector3Array Ellipsoid::geodetic_to_3d_vector3_array(const PackedVector3Array &lat_lon_alt) const {
+    const int64_t count = lat_lon_alt.size();
+    PackedVector3Array res;
+    res.resize(count);
+    const Vector3 *in = lat_lon_alt.ptr();
+    Vector3 *out = res.ptrw();
+    const double a = _axis.x, e2 = _e2;
+
+    parallel_for(count, GEODETIC_BATCH_GRAIN, [&](int64_t begin, int64_t end) {
+        double xyz[3];
+        for (int64_t i = begin; i < end; ++i) {
+            geodetic_point(a, e2, in[i].x, in[i].y, in[i].z, xyz);
+            out[i] = Vector3(xyz[0], xyz[1], xyz[2]);
+        }
+    });
+    return res;
+}
+
 Vector3 Ellipsoid::scale_to_geodetic_surface(const Vector3 &p) const {
+    // p is in the geodetic_to_3d frame (polar axis on Y): work with the radii along the Godot axes
     real_t beta = 1.0 / std::sqrt(
-        (p.x * p.x) * _one_over_axis_squared.x +
-        (p.y * p.y) * _one_over_axis_squared.y +
-        (p.z * p.z) * _one_over_axis_squared.z);
-    Vector3 n(beta * p.x * _one_over_axis_squared.x,
-              beta * p.y * _one_over_axis_squared.y,
-              beta * p.z * _one_over_axis_squared.z);
+        (p.x * p.x) * _one_over_cartesian_radii_squared.x +
+        (p.y * p.y) * _one_over_cartesian_radii_squared.y +
+        (p.z * p.z) * _one_over_cartesian_radii_squared.z);
+    Vector3 n(beta * p.x * _one_over_cartesian_radii_squared.x,
+              beta * p.y * _one_over_cartesian_radii_squared.y,
+              beta * p.z * _one_over_cartesian_radii_squared.z);
     real_t nlen = n.length();
     real_t alpha = (1.0 - beta) * (p.length() / nlen);
     real_t x2 = p.x * p.x;
@@ -102,14 +317,14 @@ Vector3 Ellipsoid::scale_to_geodetic_surface(const Vector3 &p) const {
     real_t dc = 0.0;
     real_t s = 0.0;
     real_t dSda = 1.0;
-    real_t dSdb = 1.0;
-    real_t dSdc = 1.0;
 
-    while (std::abs(s) > 1e-10) {
+    // Newton on alpha; the first pass only evaluates s (alpha unchanged since s = 0)
+    int iterations = 0;
+    do {
         alpha -= s / dSda;
-        da = 1.0 + (alpha * _one_over_axis_squared.x);
-        db = 1.0 + (alpha * _one_over_axis_squared.y);
-        dc = 1.0 + (alpha * _one_over_axis_squared.z);
+        da = 1.0 + (alpha * _one_over_cartesian_radii_squared.x);
+        db = 1.0 + (alpha * _one_over_cartesian_radii_squared.y);
+        dc = 1.0 + (alpha * _one_over_cartesian_radii_squared.z);
 
         real_t da2 = da * da;
         real_t db2 = db * db;
@@ -118,14 +333,14 @@ Vector3 Ellipsoid::scale_to_geodetic_surface(const Vector3 &p) const {
         real_t db3 = db * db2;
         real_t dc3 = dc * dc2;
 
-        s = x2 / (_axis_squared.x * da2) +
-            y2 / (_axis_squared.y * db2) +
-            z2 / (_axis_squared.z * dc2) - 1.0;
+        s = x2 / (_cartesian_radii_squared.x * da2) +
+            y2 / (_cartesian_radii_squared.y * db2) +
+            z2 / (_cartesian_radii_squared.z * dc2) - 1.0;
 
-        dSda = -2.0 * (x2 / (_axis_to_the_fourth.x * da3) +
-                       y2 / (_axis_to_the_fourth.y * db3) +
-                       z2 / (_axis_to_the_fourth.z * dc3));
-    }
+        dSda = -2.0 * (x2 / (_cartesian_radii_to_the_fourth.x * da3) +
+                       y2 / (_cartesian_radii_to_the_fourth.y * db3) +
+                       z2 / (_cartesian_radii_to_the_fourth.z * dc3));
+    } while (std::abs(s) > 1e-10 && ++iterations < 32);
     return Vector3(p.x / da, p.y / db, p.z / dc);
 }
 
@@ -133,11 +348,102 @@ Vector3 Ellipsoid::centric_surface_normal(const Vector3 &position) const {
     return position.normalized();
 }
 
+Vector3 Ellipsoid::get_cartesian_radii() const {
+    return _cartesian_radii;
+}
+
+Vector3 Ellipsoid::to_scaled_space(const Vector3 &p) const {
+    return Vector3(p.x * _one_over_cartesian_radii.x,
+                   p.y * _one_over_cartesian_radii.y,
+                   p.z * _one_over_cartesian_radii.z);
+}
+
+// Magnitude along `scaled_dir` at which the horizon plane of `position` is reached
+// (positions below the surface are treated as lying on it).
+static real_t horizon_culling_magnitude(const Vector3 &scaled_position, const Vector3 &scaled_dir) {
+    real_t magnitude_squared = scaled_position.length_squared();
+    real_t magnitude = std::sqrt(magnitude_squared);
+    const Vector3 direction = scaled_position / magnitude;
+
+    magnitude_squared = MAX((real_t)1.0, magnitude_squared);
+    magnitude = MAX((real_t)1.0, magnitude);
+
+    const real_t cos_alpha = direction.dot(scaled_dir);
+    const real_t sin_alpha = direction.cross(scaled_dir).length();
+    const real_t cos_beta = 1.0 / magnitude;
+    const real_t sin_beta = std::sqrt(magnitude_squared - 1.0) * cos_beta;
+    return 1.0 / (cos_alpha * cos_beta - sin_alpha * sin_beta);
+}
+
+Vector3 Ellipsoid::compute_horizon_culling_point(const Vector3 &direction_to_point, const PackedVector3Array &positions) const {
+    if (positions.is_empty() || direction_to_point == Vector3()) {
+        return Vector3();
+    }
+    const Vector3 scaled_dir = to_scaled_space(direction_to_point).normalized();
+    const Vector3 *src = positions.ptr();
+
+    real_t result_magnitude = 0.0;
+    for (int64_t i = 0; i < positions.size(); ++i) {
+        const real_t candidate = horizon_culling_magnitude(to_scaled_space(src[i]), scaled_dir);
+        // Negative or infinite: a position is more than 90° away from the direction, no occluder exists
+        if (!(candidate >= 0.0) || !std::isfinite(candidate)) {
+            return Vector3();
+        }
+        result_magnitude = MAX(result_magnitude, candidate);
+    }
+    return scaled_dir * result_magnitude;
+}
+
+bool Ellipsoid::is_occluder_point_visible(const Vector3 &camera_position, const Vector3 &occluder_point) const {
+    if (occluder_point == Vector3()) {
+        return true;
+    }
+    const Vector3 cv = to_scaled_space(camera_position);
+    const real_t vh_magnitude_squared = cv.length_squared() - 1.0;
+    const Vector3 vt = occluder_point - cv;
+    const real_t vt_dot_vc = -vt.dot(cv);
+
+    const bool occluded = (vh_magnitude_squared < 0.0)
+        ? vt_dot_vc > 0.0
+        : (vt_dot_vc > vh_magnitude_squared &&
+           vt_dot_vc * vt_dot_vc / vt.length_squared() > vh_magnitude_squared);
+    return !occluded;
+}
+
+PackedByteArray Ellipsoid::are_occluder_points_visible(const Vector3 &camera_position, const PackedVector3Array &occluder_points) const {
+    PackedByteArray res;
+    const int64_t count = occluder_points.size();
+    res.resize(count);
+    if (count == 0) {
+        return res;
+    }
+
+    // Same test as is_occluder_point_visible, camera terms hoisted and the loop kept branch-free
+    const Vector3 cv = to_scaled_space(camera_position);
+    const real_t vh_magnitude_squared = cv.length_squared() - 1.0;
+    const bool inside = vh_magnitude_squared < 0.0;
+    const Vector3 *src = occluder_points.ptr();
+    uint8_t *dst = res.ptrw();
+
+    for (int64_t i = 0; i < count; ++i) {
+        const Vector3 p = src[i];
+        const Vector3 vt = p - cv;
+        const real_t vt_dot_vc = -vt.dot(cv);
+        const real_t vt_len_squared = vt.length_squared();
+        const bool outside_occluded = vt_dot_vc > vh_magnitude_squared &&
+                                      vt_dot_vc * vt_dot_vc > vh_magnitude_squared * vt_len_squared;
+        const bool occluded = inside ? (vt_dot_vc > 0.0) : outside_occluded;
+        const bool unculled = p.x == 0.0 && p.y == 0.0 && p.z == 0.0;
+        dst[i] = (uint8_t)(unculled || !occluded);
+    }
+    return res;
+}
+
 Array Ellipsoid::intersections(const Vector3 &origin, const Vector3 &direction) const {
     Vector3 dir = direction.normalized();
-    real_t a = dir.x * dir.x * _one_over_axis_squared.x + dir.y * dir.y * _one_over_axis_squared.y + dir.z * dir.z * _one_over_axis_squared.z;
-    real_t b = 2.0 * (origin.x * dir.x * _one_over_axis_squared.x + origin.y * dir.y * _one_over_axis_squared.y + origin.z * dir.z * _one_over_axis_squared.z);
-    real_t c = origin.x * origin.x * _one_over_axis_squared.x + origin.y * origin.y * _one_over_axis_squared.y + origin.z * origin.z * _one_over_axis_squared.z - 1.0;
+    real_t a = dir.x * dir.x * _one_over_cartesian_radii_squared.x + dir.y * dir.y * _one_over_cartesian_radii_squared.y + dir.z * dir.z * _one_over_cartesian_radii_squared.z;
+    real_t b = 2.0 * (origin.x * dir.x * _one_over_cartesian_radii_squared.x + origin.y * dir.y * _one_over_cartesian_radii_squared.y + origin.z * dir.z * _one_over_cartesian_radii_squared.z);
+    real_t c = origin.x * origin.x * _one_over_cartesian_radii_squared.x + origin.y * origin.y * _one_over_cartesian_radii_squared.y + origin.z * origin.z * _one_over_cartesian_radii_squared.z - 1.0;
 
     real_t discriminant = b * b - 4 * a * c;
     Array res;
@@ -162,6 +468,49 @@ Array Ellipsoid::intersections(const Vector3 &origin, const Vector3 &direction)
     return res;
 }
 
+void Ellipsoid::intersect_rays_batch(const Vector3 &one_over_radii_squared, const Vector3 *origins, const Vector3 *directions,
+                                     int64_t count, float *r_distances) {
+    const real_t ix = one_over_radii_squared.x, iy = one_over_radii_squared.y, iz = one_over_radii_squared.z;
+    // Same quadratic as intersections(), written without branches so the loop vectorises
+    for (int64_t i = 0; i < count; ++i) {
+        const Vector3 o = origins[i];
+        Vector3 d = directions[i];
+        const real_t len2 = d.x * d.x + d.y * d.y + d.z * d.z;
+        d *= len2 > 0.0 ? 1.0 / std::sqrt(len2) : 0.0;
+
+        const real_t a = d.x * d.x * ix + d.y * d.y * iy + d.z * d.z * iz;
+        const real_t b = 2.0 * (o.x * d.x * ix + o.y * d.y * iy + o.z * d.z * iz);
+        const real_t c = o.x * o.x * ix + o.y * o.y * iy + o.z * o.z * iz - 1.0;
+        const real_t disc = b * b - 4.0 * a * c;
+
+        const real_t t = -0.5 * (b + std::copysign(std::sqrt(MAX(disc, (real_t)0.0)), b));
+        const real_t r1 = t / a;
+        const real_t r2 = c / t;
+        const real_t near_t = MIN(r1, r2);
+        const real_t far_t = MAX(r1, r2);
+        const real_t hit = near_t >= 0.0 ? near_t : far_t;
+        r_distances[i] = (disc >= 0.0 && a > 0.0 && hit >= 0.0) ? float(hit) : -1.0f;
+    }
+}
+
+PackedFloat32Array Ellipsoid::intersect_rays(const PackedVector3Array &origins, const PackedVector3Array &directions) const {
+    const int64_t count = origins.size();
+    ERR_FAIL_COND_V_MSG(directions.size() != count, PackedFloat32Array(), "origins and directions must have the same size.");
+
+    PackedFloat32Array res;
+    res.resize(count);
+    const Vector3 *o = origins.ptr();
+    const Vector3 *d = directions.ptr();
+    float *out = res.ptrw();
+    // Rays are in the geodetic_to_3d frame (polar axis on Y)
+    const Vector3 inv = _one_over_cartesian_radii_squared;
+
+    parallel_for(count, GEODETIC_BATCH_GRAIN, [&](int64_t begin, int64_t end) {
+        intersect_rays_batch(inv, o + begin, d + begin, end - begin, out + begin);
+    });
+    return res;
+}
+
 Ellipsoid *Ellipsoid::create_wgs84() {
     Ellipsoid *e = memnew(Ellipsoid);
     e->set_axis(WGS84);
@@ -3,8 +3,13 @@
 #include <godot_cpp/classes/node3d.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
 #include <godot_cpp/variant/packed_vector3_array.hpp>
 
+#include <cstdint>
+
 using namespace godot;
 
 class Ellipsoid : public Node3D {
@@ -27,10 +32,49 @@ public:
     real_t get_minimum_radius() const;
     real_t get_maximum_radius() const;
     Vector3 geodetic_to_3d(real_t latitude_deg, real_t longitude_deg, real_t altitude) const;
+    // Double-precision variant (x, y, z) for world origins / relative-to-center tiles
+    void geodetic_to_3d_double(double latitude_deg, double longitude_deg, double altitude, double r_xyz[3]) const;
+    PackedFloat64Array geodetic_to_3d_f64(double latitude_deg, double longitude_deg, double altitude) const;
+
+    // Batch conversions in double precision, chunked over the WorkerThreadPool for large inputs.
+    // geodetic_to_3d_array returns x, y, z interleaved; `altitudes` may be empty (0 m everywhere).
+    PackedFloat64Array geodetic_to_3d_array(const PackedFloat64Array &latitudes_deg, const PackedFloat64Array &longitudes_deg, const PackedFloat64Array &altitudes) const;
+    // (latitude_deg, longitude_deg, altitude) per element
+    PackedVector3Array geodetic_to_3d_vector3_array(const PackedVector3Array &lat_lon_alt) const;
+    // Raw kernel (no Node access, callable from any thread): `alt` may be null, r_xyz is interleaved
+    static void geodetic_to_3d_batch(double a, double e2, const double *lat_deg, const double *lon_deg, const double *alt,
+                                     int64_t count, double *r_xyz);
+    double get_eccentricity_squared() const { return _e2; }
+
+    // Inverse of geodetic_to_3d: (latitude_deg, longitude_deg, altitude). Closed form (Vermeille),
+    // with a bounded Bowring iteration for the few km around the centre where it does not apply.
+    Vector3 cartesian_to_geodetic(const Vector3 &position) const;
+    void cartesian_to_geodetic_double(double x, double y, double z, double r_lat_lon_alt[3]) const;
+    PackedFloat64Array cartesian_to_geodetic_f64(double x, double y, double z) const;
+    // Batch variants: x, y, z interleaved in, latitude, longitude, altitude interleaved out
+    PackedFloat64Array cartesian_to_geodetic_array(const PackedFloat64Array &xyz) const;
+    PackedVector3Array cartesian_to_geodetic_vector3_array(const PackedVector3Array &positions) const;
+    static void cartesian_to_geodetic_batch(double a, double e2, const double *xyz, int64_t count, double *r_lat_lon_alt);
     Vector3 scale_to_geodetic_surface(const Vector3 &p) const;
     Array intersections(const Vector3 &origin, const Vector3 &direction) const;
+    // Batch variant for picking / line of sight: distance along each (normalised) direction to the
+    // nearest hit in front of the origin (the exit point when the origin is inside), -1 on a miss.
+    PackedFloat32Array intersect_rays(const PackedVector3Array &origins, const PackedVector3Array &directions) const;
+    static void intersect_rays_batch(const Vector3 &one_over_radii_squared, const Vector3 *origins, const Vector3 *directions,
+                                     int64_t count, float *r_distances);
     Vector3 centric_surface_normal(const Vector3 &position) const;
 
+    // Radii along the cartesian X/Y/Z axes as laid out by geodetic_to_3d (polar axis on Y).
+    Vector3 get_cartesian_radii() const;
+
+    // Horizon culling (ellipsoidal occluder, scaled-space formulation as used by Cesium).
+    // compute_horizon_culling_point returns the scaled-space occluder point for a set of positions
+    // (e.g. tile corners), or Vector3() when the set spans too much of the ellipsoid to be culled.
+    Vector3 compute_horizon_culling_point(const Vector3 &direction_to_point, const PackedVector3Array &positions) const;
+    bool is_occluder_point_visible(const Vector3 &camera_position, const Vector3 &occluder_point) const;
+    // Batch variant: one byte per occluder point (1 = visible, 0 = hidden behind the horizon).
+    PackedByteArray are_occluder_points_visible(const Vector3 &camera_position, const PackedVector3Array &occluder_points) const;
+
     // Factory static methods to create Ellipsoid instances initialized with common axes
     static Ellipsoid *create_wgs84();
     static Ellipsoid *create_scaled_wgs84();
@@ -41,6 +85,14 @@ private:
     Vector3 _axis_squared;
     Vector3 _axis_to_the_fourth;
     Vector3 _one_over_axis_squared;
+    Vector3 _cartesian_radii;
+    Vector3 _one_over_cartesian_radii;
+    Vector3 _cartesian_radii_squared;
+    Vector3 _cartesian_radii_to_the_fourth;
+    Vector3 _one_over_cartesian_radii_squared;
+    double _e2 = 0.0; // first eccentricity squared, from axis.x (equatorial) and axis.z (polar)
+
+    Vector3 to_scaled_space(const Vector3 &p) const;
 
     static const Vector3 WGS84;
     static const Vector3 SCALED_WGS84;
@@ -0,0 +1,144 @@
+#include "FloatingOrigin.hpp"
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <vector>
+
+using namespace godot;
+
+FloatingOrigin::FloatingOrigin() {}
+FloatingOrigin::~FloatingOrigin() {}
+
+void FloatingOrigin::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_reference_origin", "origin"), &FloatingOrigin::set_reference_origin);
+    ClassDB::bind_method(D_METHOD("get_reference_origin"), &FloatingOrigin::get_reference_origin);
+    ClassDB::bind_method(D_METHOD("set_rebase_distance", "distance"), &FloatingOrigin::set_rebase_distance);
+    ClassDB::bind_method(D_METHOD("get_rebase_distance"), &FloatingOrigin::get_rebase_distance);
+    ClassDB::bind_method(D_METHOD("set_camera", "camera"), &FloatingOrigin::set_camera);
+    ClassDB::bind_method(D_METHOD("get_camera"), &FloatingOrigin::get_camera);
+    ClassDB::bind_method(D_METHOD("add_rtc_node", "node", "origin"), &FloatingOrigin::add_rtc_node);
+    ClassDB::bind_method(D_METHOD("remove_rtc_node", "node"), &FloatingOrigin::remove_rtc_node);
+    ClassDB::bind_method(D_METHOD("get_camera_world_position"), &FloatingOrigin::get_camera_world_position);
+    ClassDB::bind_method(D_METHOD("rebase", "new_reference"), &FloatingOrigin::rebase);
+
+    ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT64_ARRAY, "reference_origin"), "set_reference_origin", "get_reference_origin");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "rebase_distance", PROPERTY_HINT_RANGE, "0,1000000,1,or_greater"), "set_rebase_distance", "get_rebase_distance");
+}
+
+void FloatingOrigin::_ready() {
+    // Never re-base in the editor: it would rewrite the transforms saved in the scene
+    if (Engine::get_singleton()->is_editor_hint()) return;
+    set_process(true);
+}
+
+void FloatingOrigin::_process(double delta) {
+    Node3D *camera = get_camera();
+    if (!camera || rebase_distance <= 0.0) return;
+
+    // Camera position is local to this node: re-base once it drifts too far from the float origin
+    const Vector3 p = camera->get_position();
+    if ((double)p.length() < rebase_distance) return;
+
+    PackedFloat64Array new_reference;
+    new_reference.resize(3);
+    new_reference.set(0, reference[0] + p.x);
+    new_reference.set(1, reference[1] + p.y);
+    new_reference.set(2, reference[2] + p.z);
+    rebase(new_reference);
+}
+
+void FloatingOrigin::set_reference_origin(const PackedFloat64Array &origin) {
+    ERR_FAIL_COND(origin.size() != 3);
+    reference[0] = origin[0];
+    reference[1] = origin[1];
+    reference[2] = origin[2];
+    update_all();
+}
+
+PackedFloat64Array FloatingOrigin::get_reference_origin() const {
+    PackedFloat64Array res;
+    res.resize(3);
+    res.set(0, reference[0]);
+    res.set(1, reference[1]);
+    res.set(2, reference[2]);
+    return res;
+}
+
+void FloatingOrigin::set_rebase_distance(double distance) {
+    rebase_distance = MAX(0.0, distance);
+}
+
+double FloatingOrigin::get_rebase_distance() const {
+    return rebase_distance;
+}
+
+void FloatingOrigin::set_camera(Node3D *camera) {
+    camera_id = camera ? ObjectID(camera->get_instance_id()) : ObjectID();
+}
+
+Node3D *FloatingOrigin::get_camera() const {
+    if (camera_id.is_null()) return nullptr;
+    return Object::cast_to<Node3D>(ObjectDB::get_instance(camera_id));
+}
+
+void FloatingOrigin::add_rtc_node(Node3D *node, const PackedFloat64Array &origin) {
+    ERR_FAIL_NULL(node);
+    ERR_FAIL_COND(origin.size() != 3);
+    RtcEntry entry;
+    entry.x = origin[0];
+    entry.y = origin[1];
+    entry.z = origin[2];
+    rtc_nodes[node->get_instance_id()] = entry;
+    apply_entry(node, entry);
+}
+
+void FloatingOrigin::remove_rtc_node(Node3D *node) {
+    ERR_FAIL_NULL(node);
+    rtc_nodes.erase(node->get_instance_id());
+}
+
+PackedFloat64Array FloatingOrigin::get_camera_world_position() const {
+    PackedFloat64Array res = get_reference_origin();
+    if (Node3D *camera = get_camera()) {
+        const Vector3 p = camera->get_position();
+        res.set(0, res[0] + p.x);
+        res.set(1, res[1] + p.y);
+        res.set(2, res[2] + p.z);
+    }
+    return res;
+}
+
+void FloatingOrigin::rebase(const PackedFloat64Array &new_reference) {
+    ERR_FAIL_COND(new_reference.size() != 3);
+    const double dx = new_reference[0] - reference[0];
+    const double dy = new_reference[1] - reference[1];
+    const double dz = new_reference[2] - reference[2];
+
+    // The camera keeps its world position: shift it by the same (small) delta
+    if (Node3D *camera = get_camera()) {
+        const Vector3 p = camera->get_position();
+        camera->set_position(Vector3(double(p.x) - dx, double(p.y) - dy, double(p.z) - dz));
+    }
+    set_reference_origin(new_reference);
+}
+
+void FloatingOrigin::apply_entry(Node3D *node, const RtcEntry &entry) const {
+    // Difference in double first: only the small result is rounded to float
+    node->set_position(Vector3(entry.x - reference[0], entry.y - reference[1], entry.z - reference[2]));
+}
+
+void FloatingOrigin::update_all() {
+    std::vector<uint64_t> stale;
+    for (const KeyValue<uint64_t, RtcEntry> &kv : rtc_nodes) {
+        Node3D *node = Object::cast_to<Node3D>(ObjectDB::get_instance(ObjectID(kv.key)));
+        if (!node) {
+            stale.push_back(kv.key);
+            continue;
+        }
+        apply_entry(node, kv.value);
+    }
+    for (uint64_t id : stale) {
+        rtc_nodes.erase(id);
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+
+using namespace godot;
+
+// Keeps relative-to-center (RTC) content near the float origin.
+// Registered nodes carry a double-precision world origin (e.g. HeightmapTessellator's
+// "rtc_origin"); their float position is recomputed as origin - reference in double.
+// When a tracked camera drifts further than rebase_distance, the reference moves to the
+// camera and everything (camera included) is shifted back, so vertices stay at metre scale
+// without jitter on single-precision builds.
+class FloatingOrigin : public Node3D {
+    GDCLASS(FloatingOrigin, Node3D);
+
+protected:
+    static void _bind_methods();
+
+public:
+    FloatingOrigin();
+    ~FloatingOrigin();
+
+    void _ready() override;
+    void _process(double delta) override;
+
+    void set_reference_origin(const PackedFloat64Array &origin);
+    PackedFloat64Array get_reference_origin() const;
+
+    void set_rebase_distance(double distance);
+    double get_rebase_distance() const;
+
+    void set_camera(Node3D *camera);
+    Node3D *get_camera() const;
+
+    // Register a node with its double-precision world origin (PackedFloat64Array [x, y, z])
+    void add_rtc_node(Node3D *node, const PackedFloat64Array &origin);
+    void remove_rtc_node(Node3D *node);
+
+    // Double-precision world position of the tracked camera
+    PackedFloat64Array get_camera_world_position() const;
+
+    void rebase(const PackedFloat64Array &new_reference);
+
+private:
+    struct RtcEntry {
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+    };
+
+    double reference[3] = { 0.0, 0.0, 0.0 };
+    double rebase_distance = 10000.0;
+    ObjectID camera_id;
+    HashMap<uint64_t, RtcEntry> rtc_nodes;
+
+    void apply_entry(Node3D *node, const RtcEntry &entry) const;
+    void update_all();
+};
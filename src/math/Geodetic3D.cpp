@@ -1,6 +1,8 @@
 #include "Geodetic3D.hpp"
+#include "GeodeticGroup.hpp"
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
 
 using namespace godot;
 
@@ -16,6 +18,7 @@ void Geodetic3D::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get_altitude"), &Geodetic3D::get_altitude);
 
     ClassDB::bind_method(D_METHOD("update_3d_position"), &Geodetic3D::update_3d_position);
+    ClassDB::bind_method(D_METHOD("is_dirty"), &Geodetic3D::is_dirty);
 
     // Property bindings
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "latitude", PROPERTY_HINT_RANGE, "-89.99,89.99,0.01"), "set_latitude", "get_latitude");
@@ -23,44 +26,80 @@ void Geodetic3D::_bind_methods() {
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "altitude"), "set_altitude", "get_altitude");
 }
 
-void Geodetic3D::_ready() {
-    ellipsoid = find_ellipsoid_parent(this);
-    if (!ellipsoid) {
+void Geodetic3D::_enter_tree() {
+    // Single walk up: a GeodeticGroup (which caches the ellipsoid for all its markers) or an Ellipsoid
+    group = nullptr;
+    ellipsoid = nullptr;
+    for (Node *n = get_parent(); n; n = n->get_parent()) {
+        if (GeodeticGroup *g = Object::cast_to<GeodeticGroup>(n)) {
+            group = g;
+            break;
+        }
+        if (Ellipsoid *e = Object::cast_to<Ellipsoid>(n)) {
+            ellipsoid = e;
+            break;
+        }
+    }
+    if (!group && !ellipsoid) {
         UtilityFunctions::push_error("No Ellipsoid found in parent hierarchy");
         return;
     }
-    update_3d_position();
+    dirty = false;
+    mark_dirty();
+}
+
+void Geodetic3D::_exit_tree() {
+    if (group && dirty) {
+        group->remove_marker(this);
+    }
+    group = nullptr;
+    ellipsoid = nullptr;
 }
 
 void Geodetic3D::set_latitude(real_t p_lat) {
     latitude = p_lat;
-    update_3d_position();
+    mark_dirty();
 }
 real_t Geodetic3D::get_latitude() const { return latitude; }
 
 void Geodetic3D::set_longitude(real_t p_lon) {
     longitude = p_lon;
-    update_3d_position();
+    mark_dirty();
 }
 real_t Geodetic3D::get_longitude() const { return longitude; }
 
 void Geodetic3D::set_altitude(real_t p_alt) {
     altitude = p_alt;
-    update_3d_position();
+    mark_dirty();
 }
 real_t Geodetic3D::get_altitude() const { return altitude; }
 
-void Geodetic3D::update_3d_position() {
-    if (!ellipsoid) return;
-    Vector3 pos = ellipsoid->geodetic_to_3d(latitude, longitude, altitude);
-    set_position(pos);
+void Geodetic3D::mark_dirty() {
+    if (dirty) return;
+    if (group) {
+        dirty = true;
+        group->queue_update(this);
+    } else if (ellipsoid) {
+        dirty = true;
+        callable_mp(this, &Geodetic3D::flush_position).call_deferred();
+    }
+    // Outside the tree: _enter_tree converts the current coordinates
 }
 
-Ellipsoid *Geodetic3D::find_ellipsoid_parent(Node *node) const {
-    if (!node) return nullptr;
-    if (node->is_class(Ellipsoid::get_class_static())) {
-        return Object::cast_to<Ellipsoid>(node);
+void Geodetic3D::flush_position() {
+    if (dirty) update_3d_position();
+}
+
+void Geodetic3D::update_3d_position() {
+    Ellipsoid *e = group ? group->get_ellipsoid() : ellipsoid;
+    if (!e) return;
+    if (group && dirty) {
+        group->remove_marker(this);
     }
-    if (node->get_parent()) return find_ellipsoid_parent(node->get_parent());
-    return nullptr;
+    apply_position(e->geodetic_to_3d(latitude, longitude, altitude));
+}
+
+void Geodetic3D::apply_position(const Vector3 &position) {
+    dirty = false;
+    set_position(position);
 }
@@ -8,6 +8,8 @@
 
 using namespace godot;
 
+class GeodeticGroup;
+
 class Geodetic3D : public Node3D {
     GDCLASS(Geodetic3D, Node3D);
 
@@ -18,7 +20,8 @@ public:
     Geodetic3D();
     ~Geodetic3D();
 
-    void _ready() override;
+    void _enter_tree() override;
+    void _exit_tree() override;
 
     void set_latitude(real_t p_lat);
     real_t get_latitude() const;
@@ -27,14 +30,23 @@ public:
     void set_altitude(real_t p_alt);
     real_t get_altitude() const;
 
+    // Convert now. Setters only mark the marker dirty: the conversion happens once, at the end of
+    // the frame (deferred call) or in the GeodeticGroup batch when the marker belongs to one.
     void update_3d_position();
+    bool is_dirty() const { return dirty; }
 
 private:
+    friend class GeodeticGroup;
     real_t latitude = 0.0;
     real_t longitude = 0.0;
     real_t altitude = 0.0;
 
     Ellipsoid *ellipsoid = nullptr;
+    GeodeticGroup *group = nullptr;
+    int64_t group_slot = -1; // index in the group's queue, -1 when not queued
+    bool dirty = false;
 
-    Ellipsoid *find_ellipsoid_parent(Node *node) const;
+    void mark_dirty();
+    void flush_position();
+    void apply_position(const Vector3 &position);
 };
@@ -0,0 +1,135 @@
+#include "GeodeticGroup.hpp"
+#include "Ellipsoid.hpp"
+#include "Geodetic3D.hpp"
+#include "ParallelFor.hpp"
+
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+using namespace godot;
+
+GeodeticGroup::GeodeticGroup() {}
+GeodeticGroup::~GeodeticGroup() {}
+
+void GeodeticGroup::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_ellipsoid", "ellipsoid"), &GeodeticGroup::set_ellipsoid);
+    ClassDB::bind_method(D_METHOD("get_ellipsoid"), &GeodeticGroup::get_ellipsoid);
+    ClassDB::bind_method(D_METHOD("flush"), &GeodeticGroup::flush);
+    ClassDB::bind_method(D_METHOD("get_pending_count"), &GeodeticGroup::get_pending_count);
+}
+
+void GeodeticGroup::_notification(int p_what) {
+    if (p_what == NOTIFICATION_EXIT_TREE) {
+        // The group may be re-parented under another Ellipsoid
+        ancestor_id = ObjectID();
+    }
+}
+
+void GeodeticGroup::set_ellipsoid(Ellipsoid *p_ellipsoid) {
+    ellipsoid_id = p_ellipsoid ? ObjectID(p_ellipsoid->get_instance_id()) : ObjectID();
+}
+
+Ellipsoid *GeodeticGroup::get_ellipsoid() {
+    if (!ellipsoid_id.is_null()) {
+        if (Ellipsoid *e = Object::cast_to<Ellipsoid>(ObjectDB::get_instance(ellipsoid_id))) {
+            return e;
+        }
+    }
+    if (!ancestor_id.is_null()) {
+        if (Ellipsoid *e = Object::cast_to<Ellipsoid>(ObjectDB::get_instance(ancestor_id))) {
+            return e;
+        }
+        ancestor_id = ObjectID();
+    }
+    for (Node *n = get_parent(); n; n = n->get_parent()) {
+        if (Ellipsoid *e = Object::cast_to<Ellipsoid>(n)) {
+            ancestor_id = ObjectID(e->get_instance_id());
+            return e;
+        }
+    }
+    return nullptr;
+}
+
+int GeodeticGroup::get_pending_count() const {
+    return pending_count;
+}
+
+void GeodeticGroup::queue_update(Geodetic3D *marker) {
+    marker->group_slot = (int64_t)pending.size();
+    pending.push_back(marker);
+    ++pending_count;
+    // Deferred calls run after every _process of the frame: setters called from any node's
+    // _process land in this frame's conversion, unlike a flush from our own _process
+    if (!flush_queued) {
+        flush_queued = true;
+        callable_mp(this, &GeodeticGroup::flush).call_deferred();
+    }
+}
+
+void GeodeticGroup::remove_marker(Geodetic3D *marker) {
+    // The slot indexes `pending`, or `processing` while a flush is scattering positions
+    const int64_t slot = marker->group_slot;
+    marker->group_slot = -1;
+    if (slot < 0) {
+        return;
+    }
+    if (slot < (int64_t)pending.size() && pending[slot] == marker) {
+        pending[slot] = nullptr;
+        --pending_count;
+    } else if (slot < (int64_t)processing.size() && processing[slot] == marker) {
+        processing[slot] = nullptr;
+    }
+}
+
+void GeodeticGroup::flush() {
+    flush_queued = false;
+    if (pending.empty()) {
+        return;
+    }
+    Ellipsoid *e = get_ellipsoid();
+    if (!e) {
+        UtilityFunctions::push_error("GeodeticGroup: no Ellipsoid set or found in parent hierarchy");
+        return;
+    }
+
+    // Markers moved by set_position callbacks are queued again for the next flush
+    processing.swap(pending);
+    pending_count = 0;
+
+    // Drop removed markers; the survivors' slots now index `processing`
+    int64_t count = 0;
+    for (Geodetic3D *marker : processing) {
+        if (marker) {
+            marker->group_slot = count;
+            processing[count++] = marker;
+        }
+    }
+    processing.resize(count);
+
+    // Gather (structure of arrays), convert in one pass, scatter back on the main thread
+    lat.resize(count);
+    lon.resize(count);
+    alt.resize(count);
+    xyz.resize(count * 3);
+    for (int64_t i = 0; i < count; ++i) {
+        lat[i] = processing[i]->get_latitude();
+        lon[i] = processing[i]->get_longitude();
+        alt[i] = processing[i]->get_altitude();
+    }
+
+    const double a = e->get_axis().x;
+    const double e2 = e->get_eccentricity_squared();
+    parallel_for(count, 4096, [&](int64_t begin, int64_t end) {
+        Ellipsoid::geodetic_to_3d_batch(a, e2, lat.data() + begin, lon.data() + begin, alt.data() + begin,
+                                        end - begin, xyz.data() + begin * 3);
+    });
+
+    for (int64_t i = 0; i < count; ++i) {
+        if (Geodetic3D *marker = processing[i]) {
+            marker->group_slot = -1;
+            marker->apply_position(Vector3(xyz[i * 3], xyz[i * 3 + 1], xyz[i * 3 + 2]));
+        }
+    }
+    processing.clear();
+}
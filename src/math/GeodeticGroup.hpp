@@ -0,0 +1,53 @@
+#pragma once
+
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/object_id.hpp>
+
+#include <vector>
+
+using namespace godot;
+
+class Ellipsoid;
+class Geodetic3D;
+
+// Parent node for many Geodetic3D markers. Markers whose coordinates changed are queued and
+// converted together at the end of the frame with Ellipsoid::geodetic_to_3d_batch (one conversion per
+// marker per frame, whatever the number of setter calls). The Ellipsoid is looked up once for
+// the whole group instead of once per marker.
+class GeodeticGroup : public Node3D {
+    GDCLASS(GeodeticGroup, Node3D);
+
+protected:
+    static void _bind_methods();
+    void _notification(int p_what);
+
+public:
+    GeodeticGroup();
+    ~GeodeticGroup();
+
+    // Explicit ellipsoid; otherwise the nearest Ellipsoid ancestor, resolved on first use
+    // and looked up again after the group leaves the tree
+    void set_ellipsoid(Ellipsoid *ellipsoid);
+    Ellipsoid *get_ellipsoid();
+
+    // Convert every queued marker now (deferred automatically by the first queue_update of a frame)
+    void flush();
+    int get_pending_count() const;
+
+    // The marker remembers its slot in the queue, so removing it is O(1) (the slot is nulled)
+    void queue_update(Geodetic3D *marker);
+    void remove_marker(Geodetic3D *marker);
+
+private:
+    // ObjectID rather than pointers: the Ellipsoid node can be freed before the group
+    ObjectID ellipsoid_id;
+    ObjectID ancestor_id;
+    std::vector<Geodetic3D *> pending;
+    std::vector<Geodetic3D *> processing;
+    int pending_count = 0; // `pending` minus its nulled slots
+    bool flush_queued = false;
+
+    // Reused between frames
+    std::vector<double> lat, lon, alt, xyz;
+};
@@ -0,0 +1,53 @@
+#include "ParallelFor.hpp"
+
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/core/defs.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+
+#include <cstdint>
+
+namespace godot {
+
+namespace {
+
+struct ParallelForContext {
+    const std::function<void(int64_t, int64_t)> *body;
+    int64_t count;
+    int64_t chunk;
+};
+
+// Group task entry point: the context travels as an integer bound argument (a Variant cannot hold a
+// pointer), it lives on the caller's stack until wait_for_group_task_completion returns.
+void run_chunk(uint32_t index, int64_t context) {
+    const ParallelForContext &ctx = *reinterpret_cast<const ParallelForContext *>(context);
+    const int64_t begin = int64_t(index) * ctx.chunk;
+    const int64_t end = MIN(begin + ctx.chunk, ctx.count);
+    (*ctx.body)(begin, end);
+}
+
+} // namespace
+
+void parallel_for(int64_t count, int64_t grain, const std::function<void(int64_t, int64_t)> &body) {
+    if (count <= 0) {
+        return;
+    }
+    grain = MAX(grain, int64_t(1));
+
+    // A few chunks per thread so that uneven chunks still balance
+    const int64_t threads = MAX(int64_t(OS::get_singleton()->get_processor_count()), int64_t(1));
+    const int64_t chunk = MAX(grain, (count + threads * 4 - 1) / (threads * 4));
+    const int64_t chunks = (count + chunk - 1) / chunk;
+    if (chunks <= 1) {
+        body(0, count);
+        return;
+    }
+
+    ParallelForContext ctx{ &body, count, chunk };
+    WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+    const int64_t group = pool->add_group_task(callable_mp_static(&run_chunk).bind(int64_t(reinterpret_cast<intptr_t>(&ctx))),
+                                               int32_t(chunks), -1, true, "parallel_for");
+    pool->wait_for_group_task_completion(group);
+}
+
+} // namespace godot
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace godot {
+
+// Split [0, count) into chunks of at least `grain` items and run body(begin, end) for each chunk
+// on the WorkerThreadPool, returning once all chunks are done. Small ranges run inline on the
+// calling thread. The body must be safe to run concurrently on disjoint ranges.
+void parallel_for(int64_t count, int64_t grain, const std::function<void(int64_t, int64_t)> &body);
+
+} // namespace godot
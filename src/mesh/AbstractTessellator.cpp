@@ -1,4 +1,17 @@
 #include "AbstractTessellator.hpp"
+#include <math/Ellipsoid.hpp>
+
+#include <godot_cpp/classes/mesh.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
 
 using namespace godot;
 
@@ -7,9 +20,308 @@ AbstractTessellator::~AbstractTessellator() {}
 
 void AbstractTessellator::_bind_methods() {
     ClassDB::bind_method(D_METHOD("create_mesh", "subdivisions", "radius"), &AbstractTessellator::create_mesh);
+    ClassDB::bind_method(D_METHOD("create_array_mesh", "subdivisions", "radius"), &AbstractTessellator::create_array_mesh);
+    ClassDB::bind_method(D_METHOD("create_mesh_rid", "subdivisions", "radius"), &AbstractTessellator::create_mesh_rid);
+    ClassDB::bind_method(D_METHOD("create_mesh_on_ellipsoid", "subdivisions", "ellipsoid"), &AbstractTessellator::create_mesh_on_ellipsoid);
+    ClassDB::bind_method(D_METHOD("create_mesh_async", "subdivisions", "radius"), &AbstractTessellator::create_mesh_async);
+    ClassDB::bind_method(D_METHOD("benchmark", "max_subdivisions", "radius"), &AbstractTessellator::benchmark, DEFVAL(1.0));
+}
+
+bool AbstractTessellator::generate(int subdivisions, real_t radius, PackedVector3Array &vertices, PackedInt32Array &indices) {
+    // Default implementation generates nothing
+    return false;
 }
 
 Dictionary AbstractTessellator::create_mesh(int subdivisions, real_t radius) {
-    // Default implementation returns an empty dictionary
-    return Dictionary();
+    PackedVector3Array vertices;
+    PackedInt32Array indices;
+    if (!generate(subdivisions, radius, vertices, indices)) {
+        return Dictionary();
+    }
+    Dictionary res;
+    res["vertices"] = vertices;
+    res["indices"] = indices;
+    return res;
+}
+
+Ref<ArrayMesh> AbstractTessellator::create_array_mesh(int subdivisions, real_t radius) {
+    const Array arrays = to_mesh_arrays(create_mesh(subdivisions, radius));
+    ERR_FAIL_COND_V(arrays.is_empty(), Ref<ArrayMesh>());
+
+    Ref<ArrayMesh> mesh;
+    mesh.instantiate();
+    mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+    return mesh;
+}
+
+RID AbstractTessellator::create_mesh_rid(int subdivisions, real_t radius) {
+    const Array arrays = to_mesh_arrays(create_mesh(subdivisions, radius));
+    ERR_FAIL_COND_V(arrays.is_empty(), RID());
+
+    RenderingServer *rs = RenderingServer::get_singleton();
+    const RID mesh = rs->mesh_create();
+    rs->mesh_add_surface_from_arrays(mesh, RenderingServer::PRIMITIVE_TRIANGLES, arrays);
+    return mesh;
+}
+
+Dictionary AbstractTessellator::create_mesh_on_ellipsoid(int subdivisions, Ellipsoid *ellipsoid) {
+    ERR_FAIL_COND_V(ellipsoid == nullptr, Dictionary());
+
+    PackedVector3Array vertices;
+    PackedInt32Array indices;
+    if (!generate(subdivisions, 1.0, vertices, indices)) {
+        return Dictionary();
+    }
+
+    // Radii along the Godot axes (polar axis on Y, cf. Ellipsoid::geodetic_to_3d)
+    const Vector3 radii = ellipsoid->get_cartesian_radii();
+    const double inv_r2[3] = { 1.0 / (double(radii.x) * radii.x), 1.0 / (double(radii.y) * radii.y), 1.0 / (double(radii.z) * radii.z) };
+
+    const int64_t count = vertices.size();
+    PackedVector3Array normals;
+    PackedVector2Array uvs;
+    PackedFloat32Array tangents;
+    normals.resize(count);
+    uvs.resize(count);
+    tangents.resize(count * 4);
+
+    Vector3 *vtx = vertices.ptrw();
+    Vector3 *nrm = normals.ptrw();
+    Vector2 *uv = uvs.ptrw();
+    float *tan = tangents.ptrw();
+
+    for (int64_t i = 0; i < count; ++i) {
+        const double dx = vtx[i].x, dy = vtx[i].y, dz = vtx[i].z;
+        // Geocentric projection: p = d / sqrt(d² / r²) lies on the surface
+        const double k = 1.0 / std::sqrt(dx * dx * inv_r2[0] + dy * dy * inv_r2[1] + dz * dz * inv_r2[2]);
+        const double px = dx * k, py = dy * k, pz = dz * k;
+        vtx[i] = Vector3(px, py, pz);
+
+        // Geodetic normal = gradient of the implicit surface
+        double nx = px * inv_r2[0], ny = py * inv_r2[1], nz = pz * inv_r2[2];
+        const double inv_len = 1.0 / std::sqrt(nx * nx + ny * ny + nz * nz);
+        nx *= inv_len;
+        ny *= inv_len;
+        nz *= inv_len;
+        nrm[i] = Vector3(nx, ny, nz);
+
+        // lon' = lon - 90° in the geodetic_to_3d frame
+        const double lat = std::asin(CLAMP(ny, -1.0, 1.0));
+        const double lon_p = std::atan2(nz, nx);
+        double lon = lon_p + Math_PI * 0.5;
+        if (lon > Math_PI) {
+            lon -= 2.0 * Math_PI;
+        }
+        uv[i] = Vector2((lon + Math_PI) / (2.0 * Math_PI), 0.5 - lat / Math_PI);
+
+        // East: d(position)/d(lon), undefined at the poles where any horizontal direction works
+        tan[i * 4 + 0] = float(-std::sin(lon_p));
+        tan[i * 4 + 1] = 0.0f;
+        tan[i * 4 + 2] = float(std::cos(lon_p));
+        tan[i * 4 + 3] = 1.0f;
+    }
+
+    // Seam: a triangle crossing the antimeridian would interpolate u from ~1 back to ~0.
+    // Its low-u vertices are duplicated with u + 1 (one copy per source vertex, shared by all seam triangles).
+    // Poles: the longitude is undefined there, so each triangle touching a pole gets its own copy of the
+    // pole vertex, with u set to the mean of the two other (unwrapped) vertices.
+    HashMap<int32_t, int32_t> seam_copies;
+    LocalVector<int32_t> extra_sources;
+    LocalVector<real_t> extra_u;
+    int32_t *idx = indices.ptrw();
+    const int64_t index_count = indices.size();
+    auto add_copy = [&](int32_t src, real_t u) {
+        const int32_t copy = int32_t(count + extra_sources.size());
+        extra_sources.push_back(src);
+        extra_u.push_back(u);
+        return copy;
+    };
+    for (int64_t t = 0; t < index_count; t += 3) {
+        bool pole[3];
+        real_t u[3];
+        real_t u_min = 1.0, u_max = 0.0;
+        int pole_count = 0;
+        for (int k = 0; k < 3; ++k) {
+            const int32_t i = idx[t + k];
+            pole[k] = nrm[i].y * nrm[i].y >= 1.0 - 1e-10;
+            u[k] = uv[i].x;
+            if (pole[k]) {
+                ++pole_count;
+                continue;
+            }
+            u_min = MIN(u_min, u[k]);
+            u_max = MAX(u_max, u[k]);
+        }
+        if (pole_count == 3) {
+            continue;
+        }
+
+        const bool crosses_seam = u_max - u_min > 0.5;
+        real_t u_sum = 0.0;
+        for (int k = 0; k < 3; ++k) {
+            if (pole[k]) {
+                continue;
+            }
+            if (crosses_seam && u[k] < 0.5) {
+                const int32_t src = idx[t + k];
+                u[k] += 1.0;
+                if (const int32_t *found = seam_copies.getptr(src)) {
+                    idx[t + k] = *found;
+                } else {
+                    const int32_t copy = add_copy(src, u[k]);
+                    seam_copies.insert(src, copy);
+                    idx[t + k] = copy;
+                }
+            }
+            u_sum += u[k];
+        }
+        if (pole_count == 0) {
+            continue;
+        }
+        const real_t pole_u = u_sum / real_t(3 - pole_count);
+        for (int k = 0; k < 3; ++k) {
+            if (pole[k]) {
+                idx[t + k] = add_copy(idx[t + k], pole_u);
+            }
+        }
+    }
+
+    if (!extra_sources.is_empty()) {
+        const int64_t total = count + extra_sources.size();
+        vertices.resize(total);
+        normals.resize(total);
+        uvs.resize(total);
+        tangents.resize(total * 4);
+        vtx = vertices.ptrw();
+        nrm = normals.ptrw();
+        uv = uvs.ptrw();
+        tan = tangents.ptrw();
+        for (uint32_t e = 0; e < extra_sources.size(); ++e) {
+            const int64_t src = extra_sources[e];
+            const int64_t dst = count + e;
+            vtx[dst] = vtx[src];
+            nrm[dst] = nrm[src];
+            uv[dst] = Vector2(extra_u[e], uv[src].y);
+            // East direction for the copy's own longitude (this also gives pole copies a usable tangent)
+            const double lon_p = (double(extra_u[e]) * 2.0 - 1.0) * Math_PI - Math_PI * 0.5;
+            tan[dst * 4 + 0] = float(-std::sin(lon_p));
+            tan[dst * 4 + 1] = 0.0f;
+            tan[dst * 4 + 2] = float(std::cos(lon_p));
+            tan[dst * 4 + 3] = 1.0f;
+        }
+    }
+
+    Dictionary res;
+    res["vertices"] = vertices;
+    res["indices"] = indices;
+    res["normals"] = normals;
+    res["uvs"] = uvs;
+    res["tangents"] = tangents;
+    return res;
+}
+
+Array AbstractTessellator::to_mesh_arrays(const Dictionary &mesh) {
+    const PackedVector3Array vertices = mesh.get("vertices", PackedVector3Array());
+    if (vertices.is_empty()) {
+        return Array();
+    }
+    Array arrays;
+    arrays.resize(Mesh::ARRAY_MAX);
+    arrays[Mesh::ARRAY_VERTEX] = vertices;
+    arrays[Mesh::ARRAY_INDEX] = mesh.get("indices", PackedInt32Array());
+    if (mesh.has("normals")) {
+        arrays[Mesh::ARRAY_NORMAL] = mesh["normals"];
+    }
+    if (mesh.has("uvs")) {
+        arrays[Mesh::ARRAY_TEX_UV] = mesh["uvs"];
+    }
+    if (mesh.has("tangents")) {
+        arrays[Mesh::ARRAY_TANGENT] = mesh["tangents"];
+    }
+    return arrays;
+}
+
+Ref<MeshBuildTask> AbstractTessellator::create_mesh_async(int subdivisions, real_t radius) {
+    // The task keeps the tessellator alive until the worker is done
+    Ref<AbstractTessellator> self(this);
+    return MeshBuildTask::start([self, subdivisions, radius]() {
+        return to_mesh_arrays(self->create_mesh(subdivisions, radius));
+    }, get_class() + "::create_mesh_async");
+}
+
+void AbstractTessellator::subdivide_on_sphere(PackedVector3Array &vertices, int64_t vertex_count, PackedInt32Array &indices, int levels, real_t radius) {
+    Vector3 *v = vertices.ptrw();
+    const int64_t capacity = vertices.size();
+
+    // An edge is shared by two triangles: the first one creates the midpoint, the second reuses it
+    HashMap<uint64_t, int32_t> edge_cache;
+    auto midpoint = [&](int32_t a, int32_t b) {
+        const uint64_t key = (uint64_t(MIN(a, b)) << 32) | uint64_t(MAX(a, b));
+        if (const int32_t *found = edge_cache.getptr(key)) {
+            return *found;
+        }
+        ERR_FAIL_COND_V(vertex_count >= capacity, a);
+        const int32_t index = int32_t(vertex_count++);
+        v[index] = ((v[a] + v[b]) * 0.5).normalized() * radius;
+        edge_cache.insert(key, index);
+        return index;
+    };
+
+    // Single buffer sized once for the last level: each level splits triangle t into slots 4t..4t+3.
+    // Walking backwards, those slots only cover triangles already read (4t >= t), so no second buffer is needed.
+    int64_t count = indices.size();
+    indices.resize(count << (2 * levels));
+    int32_t *idx = indices.ptrw();
+    for (int level = 0; level < levels; ++level) {
+        edge_cache.clear();
+        edge_cache.reserve(uint32_t(count / 2));
+
+        for (int64_t t = count - 3; t >= 0; t -= 3) {
+            const int32_t a = idx[t], b = idx[t + 1], c = idx[t + 2];
+            const int32_t ab = midpoint(a, b);
+            const int32_t bc = midpoint(b, c);
+            const int32_t ca = midpoint(c, a);
+            const int32_t children[12] = { a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca };
+            int32_t *dst = idx + t * 4;
+            for (int k = 0; k < 12; ++k) {
+                dst[k] = children[k];
+            }
+        }
+        count *= 4;
+    }
+}
+
+Array AbstractTessellator::benchmark(int max_subdivisions, real_t radius) {
+    ERR_FAIL_COND_V(radius <= 0.0, Array());
+    Array levels;
+    for (int s = 0; s <= max_subdivisions; ++s) {
+        const uint64_t t0 = Time::get_singleton()->get_ticks_usec();
+        const Dictionary mesh = create_mesh(s, radius);
+        const uint64_t t1 = Time::get_singleton()->get_ticks_usec();
+
+        const PackedVector3Array vertices = mesh.get("vertices", PackedVector3Array());
+        const PackedInt32Array indices = mesh.get("indices", PackedInt32Array());
+        const Vector3 *v = vertices.ptr();
+        const int32_t *idx = indices.ptr();
+
+        double min_area = DBL_MAX, max_area = 0.0, max_error = 0.0;
+        for (int64_t t = 0; t + 2 < indices.size(); t += 3) {
+            const Vector3 &a = v[idx[t]], &b = v[idx[t + 1]], &c = v[idx[t + 2]];
+            const double area = 0.5 * (b - a).cross(c - a).length();
+            min_area = MIN(min_area, area);
+            max_area = MAX(max_area, area);
+            // The centroid is (close to) the point of the flat triangle farthest from the sphere
+            max_error = MAX(max_error, 1.0 - ((a + b + c) / 3.0).length() / radius);
+        }
+
+        Dictionary level;
+        level["subdivisions"] = s;
+        level["vertices"] = vertices.size();
+        level["triangles"] = indices.size() / 3;
+        level["usec"] = int64_t(t1 - t0);
+        level["area_ratio"] = min_area > 0.0 ? max_area / min_area : 0.0;
+        level["max_error"] = max_error;
+        levels.push_back(level);
+    }
+    return levels;
 }
@@ -1,17 +1,36 @@
 #pragma once
 
+#include <godot_cpp/classes/array_mesh.hpp>
 #include <godot_cpp/classes/ref.hpp>
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/rid.hpp>
+
+#include "MeshBuildTask.hpp"
 
 using namespace godot;
 
+class Ellipsoid;
+
 class AbstractTessellator : public RefCounted {
     GDCLASS(AbstractTessellator, RefCounted);
 
 protected:
     static void _bind_methods();
 
+    // Implemented by each tessellator: fill the packed arrays in place (resize once, then ptrw()).
+    // Returns false if nothing was generated.
+    virtual bool generate(int subdivisions, real_t radius, PackedVector3Array &vertices, PackedInt32Array &indices);
+
+    // Split every triangle in four `levels` times, sharing edge midpoints (projected on the sphere).
+    // `vertices` must already be sized for the last level; its first `vertex_count` entries are the base mesh.
+    static void subdivide_on_sphere(PackedVector3Array &vertices, int64_t vertex_count, PackedInt32Array &indices, int levels, real_t radius);
+    // create_mesh / create_mesh_on_ellipsoid result -> Mesh arrays (empty Array if there is no vertex)
+    static Array to_mesh_arrays(const Dictionary &mesh);
+
 public:
     AbstractTessellator();
     ~AbstractTessellator();
@@ -19,4 +38,25 @@ public:
     // Create a mesh representation. Returns a Dictionary with keys:
     // "vertices": PackedVector3Array, "indices": PackedInt32Array
     virtual Dictionary create_mesh(int subdivisions, real_t radius);
+
+    // Same buffers, handed straight to an ArrayMesh / a RenderingServer mesh without going through
+    // a Dictionary or a GDScript copy. The RID is owned by the caller (RenderingServer.free_rid).
+    Ref<ArrayMesh> create_array_mesh(int subdivisions, real_t radius);
+    RID create_mesh_rid(int subdivisions, real_t radius);
+
+    // Tessellate the ellipsoid instead of a sphere: the unit mesh from create_mesh is projected
+    // radially (geocentric scaling, exact and branch-free) in the frame of Ellipsoid::geodetic_to_3d.
+    // Adds, in the same pass, "normals" (geodetic surface normals), "uvs" (u = longitude, v = latitude,
+    // north at v = 0 like QuadtreeCPU) and "tangents" (east, Mesh.ARRAY_TANGENT layout).
+    Dictionary create_mesh_on_ellipsoid(int subdivisions, Ellipsoid *ellipsoid);
+
+    // Run the tessellation on the WorkerThreadPool. Mesh arrays are filled on the worker;
+    // MeshBuildTask::commit() creates the ArrayMesh on the main thread.
+    // generate must therefore only use its arguments and local state.
+    Ref<MeshBuildTask> create_mesh_async(int subdivisions, real_t radius);
+
+    // Cost/quality of each subdivision level from 0 to max_subdivisions. One Dictionary per level:
+    // "subdivisions", "vertices", "triangles", "usec" (create_mesh time),
+    // "area_ratio" (largest / smallest triangle), "max_error" (max chord error / radius)
+    Array benchmark(int max_subdivisions, real_t radius = 1.0);
 };
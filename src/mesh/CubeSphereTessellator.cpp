@@ -0,0 +1,68 @@
+#include "CubeSphereTessellator.hpp"
+
+#include <cmath>
+
+using namespace godot;
+
+CubeSphereTessellator::CubeSphereTessellator() {}
+CubeSphereTessellator::~CubeSphereTessellator() {}
+
+void CubeSphereTessellator::_bind_methods() {
+    ClassDB::bind_static_method("CubeSphereTessellator", D_METHOD("face_to_sphere", "face", "x", "y"), &CubeSphereTessellator::face_to_sphere);
+}
+
+Vector3 CubeSphereTessellator::face_to_sphere(int face, real_t x, real_t y) {
+    Vector3 v;
+    switch (face) {
+        case 0: v = Vector3(1, y, -x); break;  // +X
+        case 1: v = Vector3(-1, y, x); break;  // -X
+        case 2: v = Vector3(x, 1, -y); break;  // +Y
+        case 3: v = Vector3(x, -1, y); break;  // -Y
+        case 4: v = Vector3(x, y, 1); break;   // +Z
+        case 5: v = Vector3(-x, y, -1); break; // -Z
+        default: ERR_FAIL_V(Vector3());
+    }
+    // Cube point -> sphere, already unit length for a point on the cube
+    const real_t x2 = v.x * v.x, y2 = v.y * v.y, z2 = v.z * v.z;
+    return Vector3(v.x * std::sqrt(1.0 - (y2 + z2) * 0.5 + y2 * z2 / 3.0),
+                   v.y * std::sqrt(1.0 - (z2 + x2) * 0.5 + z2 * x2 / 3.0),
+                   v.z * std::sqrt(1.0 - (x2 + y2) * 0.5 + x2 * y2 / 3.0));
+}
+
+bool CubeSphereTessellator::generate(int subdivisions, real_t radius, PackedVector3Array &vertices, PackedInt32Array &indices) {
+    ERR_FAIL_COND_V(subdivisions < 0 || subdivisions > MAX_SUBDIVISIONS, false);
+
+    const int segments = 1 << subdivisions;
+    const int side = segments + 1;
+    const real_t step = 2.0 / segments;
+
+    vertices.resize(int64_t(6) * side * side);
+    indices.resize(int64_t(6) * segments * segments * 6);
+    Vector3 *v = vertices.ptrw();
+    int32_t *idx = indices.ptrw();
+
+    for (int face = 0; face < 6; ++face) {
+        const int32_t base = face * side * side;
+        for (int j = 0; j < side; ++j) {
+            for (int i = 0; i < side; ++i) {
+                *v++ = face_to_sphere(face, -1.0 + i * step, -1.0 + j * step) * radius;
+            }
+        }
+        // For every face d/dx x d/dy points outward: same winding as the other tessellators
+        for (int j = 0; j < segments; ++j) {
+            for (int i = 0; i < segments; ++i) {
+                const int32_t v00 = base + j * side + i;
+                const int32_t v10 = v00 + 1;
+                const int32_t v01 = v00 + side;
+                const int32_t v11 = v01 + 1;
+                *idx++ = v00;
+                *idx++ = v10;
+                *idx++ = v01;
+                *idx++ = v10;
+                *idx++ = v11;
+                *idx++ = v01;
+            }
+        }
+    }
+    return true;
+}
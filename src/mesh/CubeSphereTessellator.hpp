@@ -0,0 +1,29 @@
+#pragma once
+
+#include "AbstractTessellator.hpp"
+
+using namespace godot;
+
+// Cube projected on the sphere, same face layout as demo/globe_playground (+X, -X, +Y, -Y, +Z, -Z).
+// Each face is a (2^n + 1)² grid; faces do not share their border vertices, so a face can be
+// addressed (and later textured) on its own. Uses the analytic cube -> sphere mapping
+// x * sqrt(1 - y²/2 - z²/2 + y²z²/3) (Nowell): not equal-area, but cells are far more even
+// than with a plain normalisation of the cube.
+class CubeSphereTessellator : public AbstractTessellator {
+    GDCLASS(CubeSphereTessellator, AbstractTessellator);
+
+protected:
+    static void _bind_methods();
+
+public:
+    CubeSphereTessellator();
+    ~CubeSphereTessellator();
+
+    static constexpr int MAX_SUBDIVISIONS = 12;
+
+    // Point of the unit sphere for face coordinates (x, y) in [-1, 1]
+    static Vector3 face_to_sphere(int face, real_t x, real_t y);
+
+protected:
+    bool generate(int subdivisions, real_t radius, PackedVector3Array &vertices, PackedInt32Array &indices) override;
+};
@@ -0,0 +1,315 @@
+#include "GeodeticMultiMesh.hpp"
+#include <math/Ellipsoid.hpp>
+#include <math/ParallelFor.hpp>
+
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/world3d.hpp>
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/transform3d.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+using namespace godot;
+
+namespace {
+
+// Interleave the bits of two 16-bit cells (Z-order), so that sorted points form compact chunks
+uint32_t morton_key(double lat_deg, double lon_deg) {
+    auto spread = [](uint32_t v) {
+        v &= 0xFFFF;
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    };
+    const uint32_t u = uint32_t(CLAMP((lon_deg + 180.0) / 360.0, 0.0, 1.0) * 65535.0);
+    const uint32_t v = uint32_t(CLAMP((lat_deg + 90.0) / 180.0, 0.0, 1.0) * 65535.0);
+    return spread(u) | (spread(v) << 1);
+}
+
+} // namespace
+
+GeodeticMultiMesh::GeodeticMultiMesh() {}
+
+GeodeticMultiMesh::~GeodeticMultiMesh() {
+    free_chunks();
+}
+
+void GeodeticMultiMesh::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_mesh", "mesh"), &GeodeticMultiMesh::set_mesh);
+    ClassDB::bind_method(D_METHOD("get_mesh"), &GeodeticMultiMesh::get_mesh);
+    ClassDB::bind_method(D_METHOD("set_chunk_size", "size"), &GeodeticMultiMesh::set_chunk_size);
+    ClassDB::bind_method(D_METHOD("get_chunk_size"), &GeodeticMultiMesh::get_chunk_size);
+    ClassDB::bind_method(D_METHOD("set_align_to_surface", "enable"), &GeodeticMultiMesh::set_align_to_surface);
+    ClassDB::bind_method(D_METHOD("get_align_to_surface"), &GeodeticMultiMesh::get_align_to_surface);
+    ClassDB::bind_method(D_METHOD("set_ellipsoid", "ellipsoid"), &GeodeticMultiMesh::set_ellipsoid);
+    ClassDB::bind_method(D_METHOD("get_ellipsoid"), &GeodeticMultiMesh::get_ellipsoid);
+    ClassDB::bind_method(D_METHOD("set_points", "latitudes_deg", "longitudes_deg", "altitudes"), &GeodeticMultiMesh::set_points, DEFVAL(PackedFloat64Array()));
+    ClassDB::bind_method(D_METHOD("clear"), &GeodeticMultiMesh::clear);
+    ClassDB::bind_method(D_METHOD("get_instance_count"), &GeodeticMultiMesh::get_instance_count);
+    ClassDB::bind_method(D_METHOD("get_chunk_count"), &GeodeticMultiMesh::get_chunk_count);
+    ClassDB::bind_method(D_METHOD("get_chunk_aabb", "chunk"), &GeodeticMultiMesh::get_chunk_aabb);
+
+    ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "mesh", PROPERTY_HINT_RESOURCE_TYPE, "Mesh"), "set_mesh", "get_mesh");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "chunk_size", PROPERTY_HINT_RANGE, "16,65536,1"), "set_chunk_size", "get_chunk_size");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "align_to_surface"), "set_align_to_surface", "get_align_to_surface");
+}
+
+void GeodeticMultiMesh::_notification(int p_what) {
+    RenderingServer *rs = RenderingServer::get_singleton();
+    switch (p_what) {
+        case NOTIFICATION_ENTER_TREE: {
+            set_notify_transform(true);
+            const Ellipsoid *ancestor = find_ancestor_ellipsoid();
+            const ObjectID id = ancestor ? ObjectID(ancestor->get_instance_id()) : ObjectID();
+            const bool ancestor_changed = id != ancestor_id;
+            ancestor_id = id;
+            // Points set before an Ellipsoid ancestor was reachable, or converted against the previous one
+            if (!latitudes.is_empty() && (chunks.empty() || (ancestor_changed && ellipsoid_id.is_null()))) {
+                rebuild();
+            }
+        } break;
+        case NOTIFICATION_ENTER_WORLD: {
+            const RID scenario = get_world_3d()->get_scenario();
+            for (const Chunk &c : chunks) {
+                rs->instance_set_scenario(c.instance, scenario);
+            }
+            update_chunk_transforms();
+        } break;
+        case NOTIFICATION_EXIT_WORLD:
+            for (const Chunk &c : chunks) {
+                rs->instance_set_scenario(c.instance, RID());
+            }
+            break;
+        case NOTIFICATION_TRANSFORM_CHANGED:
+            update_chunk_transforms();
+            break;
+        case NOTIFICATION_VISIBILITY_CHANGED: {
+            const bool visible = is_visible_in_tree();
+            for (const Chunk &c : chunks) {
+                rs->instance_set_visible(c.instance, visible);
+            }
+        } break;
+        default:
+            break;
+    }
+}
+
+void GeodeticMultiMesh::set_mesh(const Ref<Mesh> &p_mesh) {
+    mesh = p_mesh;
+    rebuild();
+}
+
+Ref<Mesh> GeodeticMultiMesh::get_mesh() const { return mesh; }
+
+void GeodeticMultiMesh::set_chunk_size(int size) {
+    ERR_FAIL_COND(size < 1);
+    chunk_size = size;
+    rebuild();
+}
+
+int GeodeticMultiMesh::get_chunk_size() const { return chunk_size; }
+
+void GeodeticMultiMesh::set_align_to_surface(bool enable) {
+    align_to_surface = enable;
+    rebuild();
+}
+
+bool GeodeticMultiMesh::get_align_to_surface() const { return align_to_surface; }
+
+void GeodeticMultiMesh::set_ellipsoid(Ellipsoid *p_ellipsoid) {
+    ellipsoid_id = p_ellipsoid ? ObjectID(p_ellipsoid->get_instance_id()) : ObjectID();
+    rebuild();
+}
+
+Ellipsoid *GeodeticMultiMesh::get_ellipsoid() {
+    if (!ellipsoid_id.is_null()) {
+        if (Ellipsoid *e = Object::cast_to<Ellipsoid>(ObjectDB::get_instance(ellipsoid_id))) {
+            return e;
+        }
+    }
+    if (!ancestor_id.is_null()) {
+        if (Ellipsoid *e = Object::cast_to<Ellipsoid>(ObjectDB::get_instance(ancestor_id))) {
+            return e;
+        }
+    }
+    Ellipsoid *e = find_ancestor_ellipsoid();
+    ancestor_id = e ? ObjectID(e->get_instance_id()) : ObjectID();
+    return e;
+}
+
+Ellipsoid *GeodeticMultiMesh::find_ancestor_ellipsoid() const {
+    for (Node *n = get_parent(); n; n = n->get_parent()) {
+        if (Ellipsoid *e = Object::cast_to<Ellipsoid>(n)) {
+            return e;
+        }
+    }
+    return nullptr;
+}
+
+void GeodeticMultiMesh::set_points(const PackedFloat64Array &latitudes_deg, const PackedFloat64Array &longitudes_deg,
+                                   const PackedFloat64Array &p_altitudes) {
+    ERR_FAIL_COND_MSG(longitudes_deg.size() != latitudes_deg.size(), "latitudes and longitudes must have the same size.");
+    ERR_FAIL_COND_MSG(!p_altitudes.is_empty() && p_altitudes.size() != latitudes_deg.size(), "altitudes must be empty or match the latitudes.");
+    latitudes = latitudes_deg;
+    longitudes = longitudes_deg;
+    altitudes = p_altitudes;
+    rebuild();
+}
+
+void GeodeticMultiMesh::clear() {
+    latitudes.clear();
+    longitudes.clear();
+    altitudes.clear();
+    free_chunks();
+}
+
+int GeodeticMultiMesh::get_instance_count() const {
+    return (int)latitudes.size();
+}
+
+int GeodeticMultiMesh::get_chunk_count() const {
+    return (int)chunks.size();
+}
+
+AABB GeodeticMultiMesh::get_chunk_aabb(int chunk) const {
+    ERR_FAIL_INDEX_V(chunk, (int)chunks.size(), AABB());
+    const Chunk &c = chunks[chunk];
+    return AABB(c.aabb.position + Vector3(c.origin[0], c.origin[1], c.origin[2]), c.aabb.size);
+}
+
+void GeodeticMultiMesh::free_chunks() {
+    RenderingServer *rs = RenderingServer::get_singleton();
+    for (const Chunk &c : chunks) {
+        rs->free_rid(c.instance);
+        rs->free_rid(c.multimesh);
+    }
+    chunks.clear();
+}
+
+void GeodeticMultiMesh::rebuild() {
+    free_chunks();
+    const int64_t count = latitudes.size();
+    if (count == 0) {
+        return;
+    }
+    Ellipsoid *e = get_ellipsoid();
+    if (!e) {
+        // Not in the tree yet: nothing to convert against, set_points/set_ellipsoid will rebuild
+        return;
+    }
+
+    // Bulk conversion in double
+    std::vector<double> xyz(count * 3);
+    {
+        const double *lat = latitudes.ptr();
+        const double *lon = longitudes.ptr();
+        const double *alt = altitudes.is_empty() ? nullptr : altitudes.ptr();
+        const double a = e->get_axis().x;
+        const double e2 = e->get_eccentricity_squared();
+        parallel_for(count, 4096, [&](int64_t begin, int64_t end) {
+            Ellipsoid::geodetic_to_3d_batch(a, e2, lat + begin, lon + begin, alt ? alt + begin : nullptr, end - begin, xyz.data() + begin * 3);
+        });
+    }
+
+    // Z-order so that each chunk covers a compact area
+    std::vector<std::pair<uint32_t, int32_t>> order(count);
+    for (int64_t i = 0; i < count; ++i) {
+        order[i] = { morton_key(latitudes[i], longitudes[i]), int32_t(i) };
+    }
+    std::sort(order.begin(), order.end());
+
+    // Mesh extent, any orientation: distance from the pivot to the farthest of the 8 AABB corners
+    real_t mesh_radius = 0.0;
+    if (mesh.is_valid()) {
+        const AABB m = mesh->get_aabb();
+        const Vector3 lo = m.position.abs();
+        const Vector3 hi = (m.position + m.size).abs();
+        mesh_radius = Vector3(MAX(lo.x, hi.x), MAX(lo.y, hi.y), MAX(lo.z, hi.z)).length();
+    }
+
+    RenderingServer *rs = RenderingServer::get_singleton();
+    const RID mesh_rid = mesh.is_valid() ? mesh->get_rid() : RID();
+    const RID scenario = is_inside_tree() ? get_world_3d()->get_scenario() : RID();
+    const bool visible = is_inside_tree() ? is_visible_in_tree() : true;
+
+    PackedFloat32Array buffer;
+    for (int64_t first = 0; first < count; first += chunk_size) {
+        const int64_t n = MIN(int64_t(chunk_size), count - first);
+        Chunk c;
+
+        // Chunk origin: centroid in double, instances are stored relative to it
+        for (int64_t k = 0; k < n; ++k) {
+            const double *p = xyz.data() + order[first + k].second * 3;
+            c.origin[0] += p[0];
+            c.origin[1] += p[1];
+            c.origin[2] += p[2];
+        }
+        c.origin[0] /= n;
+        c.origin[1] /= n;
+        c.origin[2] /= n;
+
+        buffer.resize(n * 12);
+        float *b = buffer.ptrw();
+        for (int64_t k = 0; k < n; ++k) {
+            const int32_t i = order[first + k].second;
+            const double *p = xyz.data() + i * 3;
+            const Vector3 pos(p[0] - c.origin[0], p[1] - c.origin[1], p[2] - c.origin[2]);
+
+            // Columns of the instance basis; same frame as geodetic_to_3d (lon' = lon - 90°)
+            Vector3 x_axis(1, 0, 0), y_axis(0, 1, 0), z_axis(0, 0, 1);
+            if (align_to_surface) {
+                const double lat = Math::deg_to_rad(latitudes[i]);
+                const double lon = Math::deg_to_rad(longitudes[i]) - Math_PI / 2.0;
+                const double sl = std::sin(lat), cl = std::cos(lat);
+                const double so = std::sin(lon), co = std::cos(lon);
+                x_axis = Vector3(-so, 0.0, co);               // east
+                y_axis = Vector3(cl * co, sl, cl * so);       // geodetic up
+                z_axis = Vector3(-sl * co, cl, -sl * so);     // north (= east x up here: no mirroring)
+            }
+            // MultiMesh TRANSFORM_3D layout: basis rows, each followed by the origin component
+            float *t = b + k * 12;
+            t[0] = x_axis.x; t[1] = y_axis.x; t[2] = z_axis.x;  t[3] = pos.x;
+            t[4] = x_axis.y; t[5] = y_axis.y; t[6] = z_axis.y;  t[7] = pos.y;
+            t[8] = x_axis.z; t[9] = y_axis.z; t[10] = z_axis.z; t[11] = pos.z;
+
+            if (k == 0) {
+                c.aabb = AABB(pos, Vector3());
+            } else {
+                c.aabb.expand_to(pos);
+            }
+        }
+        c.aabb = c.aabb.grow(mesh_radius);
+
+        c.multimesh = rs->multimesh_create();
+        rs->multimesh_allocate_data(c.multimesh, int(n), RenderingServer::MULTIMESH_TRANSFORM_3D);
+        rs->multimesh_set_buffer(c.multimesh, buffer);
+        if (mesh_rid.is_valid()) {
+            rs->multimesh_set_mesh(c.multimesh, mesh_rid);
+        }
+
+        c.instance = rs->instance_create2(c.multimesh, scenario);
+        rs->instance_set_custom_aabb(c.instance, c.aabb);
+        rs->instance_set_visible(c.instance, visible);
+        chunks.push_back(c);
+    }
+    update_chunk_transforms();
+}
+
+void GeodeticMultiMesh::update_chunk_transforms() {
+    if (!is_inside_tree()) {
+        return;
+    }
+    RenderingServer *rs = RenderingServer::get_singleton();
+    const Transform3D global = get_global_transform();
+    for (const Chunk &c : chunks) {
+        const Transform3D local(Basis(), Vector3(c.origin[0], c.origin[1], c.origin[2]));
+        rs->instance_set_transform(c.instance, global * local);
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <godot_cpp/classes/mesh.hpp>
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/object_id.hpp>
+#include <godot_cpp/variant/aabb.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/rid.hpp>
+
+#include <vector>
+
+using namespace godot;
+
+class Ellipsoid;
+
+// Geo-anchored instancing without one node per point: packed latitude / longitude / altitude
+// arrays are converted in bulk (Ellipsoid::geodetic_to_3d_batch), sorted along a Morton curve
+// and split into RenderingServer multimeshes of chunk_size instances. Each chunk is its own
+// instance with a tight AABB, so the renderer frustum-culls whole chunks; instance positions
+// are stored relative to the chunk centre (computed in double) to keep float precision.
+// With align_to_surface, each instance has Y along the geodetic normal, X east, Z north.
+class GeodeticMultiMesh : public Node3D {
+    GDCLASS(GeodeticMultiMesh, Node3D);
+
+protected:
+    static void _bind_methods();
+    void _notification(int p_what);
+
+public:
+    GeodeticMultiMesh();
+    ~GeodeticMultiMesh();
+
+    void set_mesh(const Ref<Mesh> &mesh);
+    Ref<Mesh> get_mesh() const;
+    void set_chunk_size(int size);
+    int get_chunk_size() const;
+    void set_align_to_surface(bool enable);
+    bool get_align_to_surface() const;
+
+    // Explicit ellipsoid; otherwise the nearest Ellipsoid ancestor, resolved when points are set
+    // (the points are converted again when the node enters the tree under another ancestor)
+    void set_ellipsoid(Ellipsoid *ellipsoid);
+    Ellipsoid *get_ellipsoid();
+
+    // `altitudes` may be empty (0 m everywhere)
+    void set_points(const PackedFloat64Array &latitudes_deg, const PackedFloat64Array &longitudes_deg,
+                    const PackedFloat64Array &altitudes = PackedFloat64Array());
+    void clear();
+
+    int get_instance_count() const;
+    int get_chunk_count() const;
+    AABB get_chunk_aabb(int chunk) const;
+
+private:
+    struct Chunk {
+        RID multimesh;
+        RID instance;
+        double origin[3] = { 0.0, 0.0, 0.0 };
+        AABB aabb; // relative to origin, mesh extent included
+    };
+
+    Ref<Mesh> mesh;
+    int chunk_size = 1024;
+    bool align_to_surface = true;
+    // ObjectID rather than pointers: the Ellipsoid node can be freed before this node
+    ObjectID ellipsoid_id;
+    ObjectID ancestor_id;
+
+    PackedFloat64Array latitudes;
+    PackedFloat64Array longitudes;
+    PackedFloat64Array altitudes;
+    std::vector<Chunk> chunks;
+
+    Ellipsoid *find_ancestor_ellipsoid() const;
+    void rebuild();
+    void free_chunks();
+    void update_chunk_transforms();
+};
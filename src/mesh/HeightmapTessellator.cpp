@@ -1,50 +1,174 @@
 #include "HeightmapTessellator.hpp"
 #include <math/Ellipsoid.hpp>
+#include "VertexCacheOptimizer.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/classes/mesh.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <algorithm>
+#include <cmath>
+#include <vector>
 
 using namespace godot;
 
-Ref<ArrayMesh> HeightmapTessellator::build_mesh(const PackedFloat32Array& heights,
-                                                int n,
-                                                double lat0, double lon0,
-                                                double lat1, double lon1,
-                                                Ellipsoid* ellipsoid)
+namespace {
+
+// Tampons de travail réutilisés d'un appel à l'autre (un jeu par thread)
+struct TessellatorScratch {
+    std::vector<double> sin_lat, cos_lat, n_lat, m_lat; // par ligne
+    std::vector<double> cos_lon, sin_lon;               // par colonne
+    std::vector<Vector3> normal_row;                    // une ligne de normales (texture)
+};
+
+thread_local TessellatorScratch g_scratch;
+
+// Récupère le tableau packé d'un slot de `arrays` à la bonne taille, sans copie :
+// le slot est vidé d'abord pour que le tableau n'ait qu'une seule référence (pas de copy-on-write).
+template <typename T>
+T take_packed(Array &arrays, int slot, int64_t size) {
+    T packed;
+    if (arrays[slot].get_type() == Variant(T()).get_type()) {
+        packed = arrays[slot];
+    }
+    arrays[slot] = Variant();
+    if (packed.size() != size) {
+        packed.resize(size);
+    }
+    return packed;
+}
+
+// Tables par ligne / colonne, même repère que Ellipsoid::geodetic_to_3d
+// (axe polaire sur Y, longitude décalée de -90°)
+void fill_trig_tables(TessellatorScratch &s, int n, double lat0, double lon0, double lat1, double lon1,
+                      double a, double e2) {
+    const double inv = 1.0 / double(n - 1);
+    s.sin_lat.resize(n); s.cos_lat.resize(n); s.n_lat.resize(n); s.m_lat.resize(n);
+    s.cos_lon.resize(n); s.sin_lon.resize(n);
+    for (int i = 0; i < n; ++i) {
+        const double lat = Math::deg_to_rad(Math::lerp(lat0, lat1, i * inv));
+        const double lon = Math::deg_to_rad(Math::lerp(lon0, lon1, i * inv)) - Math_PI / 2.0;
+        s.sin_lat[i] = std::sin(lat);
+        s.cos_lat[i] = std::cos(lat);
+        const double w2 = 1.0 - e2 * s.sin_lat[i] * s.sin_lat[i];
+        s.n_lat[i] = a / std::sqrt(w2);                 // rayon de courbure du premier vertical
+        s.m_lat[i] = a * (1.0 - e2) / (w2 * std::sqrt(w2)); // rayon de courbure méridien
+        s.cos_lon[i] = std::cos(lon);
+        s.sin_lon[i] = std::sin(lon);
+    }
+}
+
+// Normales analytiques d'une ligne : différences centrales des hauteurs (en mètres sur
+// l'ellipsoïde) appliquées au repère tangent local (est, nord, verticale géodésique).
+void heightfield_normal_row(const TessellatorScratch &s, const float *h, int n, int iy,
+                            double dlat_rad, double dlon_rad, Vector3 *out) {
+    const int yl = iy > 0 ? iy - 1 : 0;
+    const int yr = iy < n - 1 ? iy + 1 : n - 1;
+    const float *row = h + iy * n;
+    const float *row_prev = h + yl * n;
+    const float *row_next = h + yr * n;
+
+    const double sl = s.sin_lat[iy], cl = s.cos_lat[iy];
+    const double d_north = s.m_lat[iy] * dlat_rad * double(yr - yl);   // mètres entre yl et yr
+    const double d_east_1 = s.n_lat[iy] * cl * dlon_rad;               // mètres par colonne
+    const double inv_north = std::abs(d_north) > 1e-9 ? 1.0 / d_north : 0.0;
+
+    for (int ix = 0; ix < n; ++ix) {
+        const int xl = ix > 0 ? ix - 1 : 0;
+        const int xr = ix < n - 1 ? ix + 1 : n - 1;
+        const double d_east = d_east_1 * double(xr - xl);
+        const double g_e = std::abs(d_east) > 1e-9 ? (row[xr] - row[xl]) / d_east : 0.0;
+        const double g_n = (row_next[ix] - row_prev[ix]) * inv_north;
+
+        const double co = s.cos_lon[ix], so = s.sin_lon[ix];
+        // up = (cl co, sl, cl so), east = (-so, 0, co), north = (-sl co, cl, -sl so)
+        const double nx = cl * co + g_e * so + g_n * sl * co;
+        const double ny = sl - g_n * cl;
+        const double nz = cl * so - g_e * co + g_n * sl * so;
+        const double len = std::sqrt(nx * nx + ny * ny + nz * nz);
+        out[ix] = Vector3(float(nx / len), float(ny / len), float(nz / len));
+    }
+}
+
+} // namespace
+
+Error HeightmapTessellator::build_mesh_arrays(const PackedFloat32Array& heights,
+                                              int n,
+                                              double lat0, double lon0,
+                                              double lat1, double lon1,
+                                              Ellipsoid* ellipsoid,
+                                              Array arrays,
+                                              bool optimize_vertex_cache,
+                                              const PackedFloat64Array& origin)
+{
+    ERR_FAIL_COND_V(ellipsoid == nullptr, ERR_INVALID_PARAMETER);
+    return fill_arrays(heights, n, lat0, lon0, lat1, lon1, ellipsoid->get_axis(), arrays, optimize_vertex_cache, origin);
+}
+
+Error HeightmapTessellator::fill_arrays(const PackedFloat32Array& heights,
+                                        int n,
+                                        double lat0, double lon0,
+                                        double lat1, double lon1,
+                                        const Vector3& axis,
+                                        Array arrays,
+                                        bool optimize_vertex_cache,
+                                        const PackedFloat64Array& origin)
 {
-    ERR_FAIL_COND_V(ellipsoid == nullptr, Ref<ArrayMesh>());
-    ERR_FAIL_COND_V(n < 2, Ref<ArrayMesh>());
-    ERR_FAIL_COND_V(heights.size() != n * n, Ref<ArrayMesh>());
+    ERR_FAIL_COND_V(n < 2, ERR_INVALID_PARAMETER);
+    ERR_FAIL_COND_V(heights.size() != n * n, ERR_INVALID_PARAMETER);
+    ERR_FAIL_COND_V(!origin.is_empty() && origin.size() != 3, ERR_INVALID_PARAMETER);
 
     const int vert_count = n * n;
+    const int index_count = (n - 1) * (n - 1) * 6;
 
-    PackedVector3Array vertices;
-    PackedVector2Array uvs;
-    vertices.resize(vert_count);
-    uvs.resize(vert_count);
+    if (arrays.size() != Mesh::ARRAY_MAX) {
+        arrays.resize(Mesh::ARRAY_MAX);
+    }
+    PackedVector3Array vertices = take_packed<PackedVector3Array>(arrays, Mesh::ARRAY_VERTEX, vert_count);
+    PackedVector3Array normals  = take_packed<PackedVector3Array>(arrays, Mesh::ARRAY_NORMAL, vert_count);
+    PackedVector2Array uvs      = take_packed<PackedVector2Array>(arrays, Mesh::ARRAY_TEX_UV, vert_count);
+    PackedInt32Array   indices  = take_packed<PackedInt32Array>(arrays, Mesh::ARRAY_INDEX, index_count);
 
-    // Génération sommets + UVs [0..1]
-    for (int iy = 0; iy < n; ++iy) {
-        const double t = (n == 1) ? 0.0 : double(iy) / double(n - 1);
-        const double lat = Math::lerp(lat0, lat1, t);
-        for (int ix = 0; ix < n; ++ix) {
-            const double u = (n == 1) ? 0.0 : double(ix) / double(n - 1);
-            const double lon = Math::lerp(lon0, lon1, u);
+    const float *h = heights.ptr();
+    Vector3 *vtx = vertices.ptrw();
+    Vector3 *nrm = normals.ptrw();
+    Vector2 *uv  = uvs.ptrw();
+    int32_t *idx = indices.ptrw();
+
+    const double a = axis.x;
+    const double b = axis.z;
+    const double e2 = 1.0 - (b * b) / (a * a);
+    const double inv = 1.0 / double(n - 1);
+    const double dlat = Math::deg_to_rad(lat1 - lat0) * inv;
+    const double dlon = Math::deg_to_rad(lon1 - lon0) * inv;
 
-            const int idx = iy * n + ix;
-            const float h = heights[idx];
+    // RTC : positions calculées en double puis rendues relatives à l'origine avant passage en float
+    const double ox = origin.is_empty() ? 0.0 : origin[0];
+    const double oy = origin.is_empty() ? 0.0 : origin[1];
+    const double oz = origin.is_empty() ? 0.0 : origin[2];
 
-            const Vector3 pos = ellipsoid->geodetic_to_3d(lat, lon, h);
-            vertices.set(idx, pos);
-            uvs.set(idx, Vector2((float)u, (float)t));
+    // Tables trigonométriques : une entrée par ligne (latitude) et par colonne (longitude)
+    TessellatorScratch &s = g_scratch;
+    fill_trig_tables(s, n, lat0, lon0, lat1, lon1, a, e2);
+
+    // Passe unique : positions, UVs et normales (dérivées de la grille de hauteurs) ligne par ligne
+    for (int iy = 0; iy < n; ++iy) {
+        const double sl = s.sin_lat[iy], cl = s.cos_lat[iy], N = s.n_lat[iy];
+        const double y_base = N * (1.0 - e2);
+        const float t = float(iy * inv);
+
+        for (int ix = 0; ix < n; ++ix) {
+            const int i = iy * n + ix;
+            const double alt = h[i];
+            const double r = (N + alt) * cl;
+            vtx[i] = Vector3(float(r * s.cos_lon[ix] - ox),
+                             float((y_base + alt) * sl - oy),
+                             float(r * s.sin_lon[ix] - oz));
+            uv[i] = Vector2(float(ix * inv), t);
         }
+        heightfield_normal_row(s, h, n, iy, dlat, dlon, nrm + iy * n);
     }
 
     // Indices (2 triangles par quad)
-    PackedInt32Array indices;
-    indices.resize((n - 1) * (n - 1) * 6);
     int ind = 0;
     for (int iy = 0; iy < n - 1; ++iy) {
         for (int ix = 0; ix < n - 1; ++ix) {
@@ -53,57 +177,157 @@ Ref<ArrayMesh> HeightmapTessellator::build_mesh(const PackedFloat32Array& height
             const int v01 = iy * n + (ix + 1);
             const int v11 = (iy + 1) * n + (ix + 1);
             // tri 1
-            indices.set(ind++, v00);
-            indices.set(ind++, v10);
-            indices.set(ind++, v01);
+            idx[ind++] = v00;
+            idx[ind++] = v10;
+            idx[ind++] = v01;
             // tri 2
-            indices.set(ind++, v10);
-            indices.set(ind++, v11);
-            indices.set(ind++, v01);
+            idx[ind++] = v10;
+            idx[ind++] = v11;
+            idx[ind++] = v01;
         }
     }
 
-    // (Option) Normales lissées – simple accumulate/normalize    
-    PackedVector3Array normals;
-    normals.resize(vert_count);
-    for (int i = 0; i < vert_count; ++i) normals.set(i, Vector3());
-
-    const int tri_count = indices.size() / 3;
-    for (int t = 0; t < tri_count; ++t) {
-        const int i0 = indices[t*3 + 0];
-        const int i1 = indices[t*3 + 1];
-        const int i2 = indices[t*3 + 2];
-        const Vector3 &p0 = vertices[i0];
-        const Vector3 &p1 = vertices[i1];
-        const Vector3 &p2 = vertices[i2];
-        const Vector3 nrm = (p1 - p0).cross(p2 - p0);
-        normals.set(i0, normals[i0] + nrm);
-        normals.set(i1, normals[i1] + nrm);
-        normals.set(i2, normals[i2] + nrm);
-    }
-    for (int i = 0; i < vert_count; ++i) {
-        Vector3 n = normals[i];
-        const real_t len = n.length();
-        if (len > (real_t)0.0) n /= len;
-        normals.set(i, n);
+    if (optimize_vertex_cache) {
+        VertexCacheOptimizer::optimize(idx, index_count, vert_count);
     }
-    
 
-    Ref<ArrayMesh> mesh = Ref<ArrayMesh>(memnew(ArrayMesh));
-
-    Array arrays;
-    arrays.resize(Mesh::ARRAY_MAX);
     arrays[Mesh::ARRAY_VERTEX] = vertices;
     arrays[Mesh::ARRAY_NORMAL] = normals;
     arrays[Mesh::ARRAY_TEX_UV] = uvs;
     arrays[Mesh::ARRAY_INDEX]  = indices;
+    return OK;
+}
+
+Ref<ArrayMesh> HeightmapTessellator::build_mesh(const PackedFloat32Array& heights,
+                                                int n,
+                                                double lat0, double lon0,
+                                                double lat1, double lon1,
+                                                Ellipsoid* ellipsoid,
+                                                bool optimize_vertex_cache,
+                                                bool relative_to_center)
+{
+    PackedFloat64Array origin;
+    if (relative_to_center) {
+        origin = compute_tile_origin(lat0, lon0, lat1, lon1, ellipsoid);
+        ERR_FAIL_COND_V(origin.is_empty(), Ref<ArrayMesh>());
+    }
 
+    Array arrays;
+    arrays.resize(Mesh::ARRAY_MAX);
+    if (build_mesh_arrays(heights, n, lat0, lon0, lat1, lon1, ellipsoid, arrays, optimize_vertex_cache, origin) != OK) {
+        return Ref<ArrayMesh>();
+    }
+
+    Ref<ArrayMesh> mesh = Ref<ArrayMesh>(memnew(ArrayMesh));
     mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+    if (relative_to_center) {
+        mesh->set_meta("rtc_origin", origin);
+    }
     return mesh;
 }
 
+Ref<MeshBuildTask> HeightmapTessellator::build_mesh_async(const PackedFloat32Array& heights,
+                                                          int n,
+                                                          double lat0, double lon0,
+                                                          double lat1, double lon1,
+                                                          Ellipsoid* ellipsoid,
+                                                          bool optimize_vertex_cache,
+                                                          bool relative_to_center)
+{
+    ERR_FAIL_COND_V(ellipsoid == nullptr, Ref<MeshBuildTask>());
+    ERR_FAIL_COND_V(n < 2, Ref<MeshBuildTask>());
+    ERR_FAIL_COND_V(heights.size() != n * n, Ref<MeshBuildTask>());
+
+    // Tout ce qui touche au nœud Ellipsoid est lu ici, sur le thread appelant :
+    // le worker ne reçoit que des copies (axes, origine RTC, hauteurs en COW)
+    const Vector3 axis = ellipsoid->get_axis();
+    PackedFloat64Array origin;
+    Dictionary meta;
+    if (relative_to_center) {
+        origin = compute_tile_origin(lat0, lon0, lat1, lon1, ellipsoid);
+        ERR_FAIL_COND_V(origin.is_empty(), Ref<MeshBuildTask>());
+        meta["rtc_origin"] = origin;
+    }
+
+    return MeshBuildTask::start([=]() {
+        Array arrays;
+        arrays.resize(Mesh::ARRAY_MAX);
+        if (fill_arrays(heights, n, lat0, lon0, lat1, lon1, axis, arrays, optimize_vertex_cache, origin) != OK) {
+            return Array();
+        }
+        return arrays;
+    }, "HeightmapTessellator::build_mesh_async", meta);
+}
+
+Ref<Image> HeightmapTessellator::build_normal_texture(const PackedFloat32Array& heights,
+                                                     int n,
+                                                     double lat0, double lon0,
+                                                     double lat1, double lon1,
+                                                     Ellipsoid* ellipsoid)
+{
+    ERR_FAIL_COND_V(ellipsoid == nullptr, Ref<Image>());
+    ERR_FAIL_COND_V(n < 2, Ref<Image>());
+    ERR_FAIL_COND_V(heights.size() != n * n, Ref<Image>());
+
+    const Vector3 axis = ellipsoid->get_axis();
+    const double a = axis.x;
+    const double b = axis.z;
+    const double e2 = 1.0 - (b * b) / (a * a);
+    const double inv = 1.0 / double(n - 1);
+
+    TessellatorScratch &s = g_scratch;
+    fill_trig_tables(s, n, lat0, lon0, lat1, lon1, a, e2);
+    s.normal_row.resize(n);
+
+    PackedByteArray data;
+    data.resize(n * n * 2);
+    uint8_t *dst = data.ptrw();
+    const float *h = heights.ptr();
+
+    for (int iy = 0; iy < n; ++iy) {
+        heightfield_normal_row(s, h, n, iy, Math::deg_to_rad(lat1 - lat0) * inv, Math::deg_to_rad(lon1 - lon0) * inv, s.normal_row.data());
+        for (int ix = 0; ix < n; ++ix) {
+            // octaèdre : projection sur |x|+|y|+|z| = 1, hémisphère z<0 replié
+            const Vector3 v = s.normal_row[ix];
+            const float l1 = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+            float ox = v.x / l1;
+            float oy = v.y / l1;
+            if (v.z < 0.0f) {
+                const float fx = (1.0f - std::abs(oy)) * (ox >= 0.0f ? 1.0f : -1.0f);
+                const float fy = (1.0f - std::abs(ox)) * (oy >= 0.0f ? 1.0f : -1.0f);
+                ox = fx;
+                oy = fy;
+            }
+            const int i = (iy * n + ix) * 2;
+            dst[i + 0] = (uint8_t)CLAMP(Math::round((ox * 0.5f + 0.5f) * 255.0f), 0.0f, 255.0f);
+            dst[i + 1] = (uint8_t)CLAMP(Math::round((oy * 0.5f + 0.5f) * 255.0f), 0.0f, 255.0f);
+        }
+    }
+
+    return Image::create_from_data(n, n, false, Image::FORMAT_RG8, data);
+}
+
+PackedFloat64Array HeightmapTessellator::compute_tile_origin(double lat0, double lon0,
+                                                             double lat1, double lon1,
+                                                             Ellipsoid* ellipsoid)
+{
+    ERR_FAIL_COND_V(ellipsoid == nullptr, PackedFloat64Array());
+    // centre géodésique de la tuile, altitude 0 ; lon1 est déroulée par rapport à lon0
+    // pour qu'une tuile à cheval sur ±180° ait son origine du bon côté du globe
+    if (lon1 - lon0 > 180.0) lon1 -= 360.0;
+    else if (lon1 - lon0 < -180.0) lon1 += 360.0;
+    double lon = (lon0 + lon1) * 0.5;
+    if (lon > 180.0) lon -= 360.0;
+    else if (lon < -180.0) lon += 360.0;
+    return ellipsoid->geodetic_to_3d_f64((lat0 + lat1) * 0.5, lon, 0.0);
+}
+
 
 void HeightmapTessellator::_bind_methods() {
     // build_mesh is declared static in the header; register as a static method.
-    ClassDB::bind_static_method("HeightmapTessellator", D_METHOD("build_mesh", "heights", "n", "lat0", "lon0", "lat1", "lon1", "ellipsoid"), &HeightmapTessellator::build_mesh);
-}
\ No newline at end of file
+    ClassDB::bind_static_method("HeightmapTessellator", D_METHOD("build_mesh", "heights", "n", "lat0", "lon0", "lat1", "lon1", "ellipsoid", "optimize_vertex_cache", "relative_to_center"), &HeightmapTessellator::build_mesh, DEFVAL(false), DEFVAL(false));
+    ClassDB::bind_static_method("HeightmapTessellator", D_METHOD("build_mesh_async", "heights", "n", "lat0", "lon0", "lat1", "lon1", "ellipsoid", "optimize_vertex_cache", "relative_to_center"), &HeightmapTessellator::build_mesh_async, DEFVAL(false), DEFVAL(false));
+    ClassDB::bind_static_method("HeightmapTessellator", D_METHOD("build_mesh_arrays", "heights", "n", "lat0", "lon0", "lat1", "lon1", "ellipsoid", "arrays", "optimize_vertex_cache", "origin"), &HeightmapTessellator::build_mesh_arrays, DEFVAL(false), DEFVAL(PackedFloat64Array()));
+    ClassDB::bind_static_method("HeightmapTessellator", D_METHOD("build_normal_texture", "heights", "n", "lat0", "lon0", "lat1", "lon1", "ellipsoid"), &HeightmapTessellator::build_normal_texture);
+    ClassDB::bind_static_method("HeightmapTessellator", D_METHOD("compute_tile_origin", "lat0", "lon0", "lat1", "lon1", "ellipsoid"), &HeightmapTessellator::compute_tile_origin);
+}
@@ -1,21 +1,30 @@
 #pragma once
 
 #include <godot_cpp/classes/array_mesh.hpp>
+#include <godot_cpp/classes/image.hpp>
 #include <godot_cpp/classes/mesh.hpp>
 #include <godot_cpp/classes/ref.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/variant/packed_vector3_array.hpp>
 #include <godot_cpp/variant/packed_vector2_array.hpp>
 #include <godot_cpp/classes/ref_counted.hpp>
 
+#include "MeshBuildTask.hpp"
+
 class Ellipsoid; // forward decl (inclu dans le .cpp)
 
 /// Génère un maillage ellipsoïdal (WGS-84) à partir d’une grille de hauteurs.
 /// - heights : n×n, rangé en ligne (iy * n + ix)
 /// - n       : nombre de points par côté
 /// - [lat0,lon0] (UL) → [lat1,lon1] (LR) en degrés
+/// - normales analytiques : différences centrales des hauteurs dans le repère tangent local
+/// - optimize_vertex_cache : réordonne les triangles (VertexCacheOptimizer)
+/// - relative_to_center    : sommets relatifs au centre de la tuile (calcul en double),
+///   l'origine ECEF est stockée en meta "rtc_origin" (PackedFloat64Array), cf. FloatingOrigin
+/// - build_mesh_async : même résultat, calculé sur le WorkerThreadPool (cf. MeshBuildTask)
 class HeightmapTessellator : public godot::RefCounted{
     GDCLASS(HeightmapTessellator, RefCounted);
 
@@ -24,9 +33,57 @@ public:
                                                     int n,
                                                     double lat0, double lon0,
                                                     double lat1, double lon1,
-                                                    Ellipsoid* ellipsoid);
+                                                    Ellipsoid* ellipsoid,
+                                                    bool optimize_vertex_cache = false,
+                                                    bool relative_to_center = false);
+
+    /// Variante asynchrone de build_mesh : les tampons sont remplis sur un thread du
+    /// WorkerThreadPool, MeshBuildTask::commit() crée l'ArrayMesh sur le thread principal.
+    static godot::Ref<MeshBuildTask> build_mesh_async(const godot::PackedFloat32Array& heights,
+                                                      int n,
+                                                      double lat0, double lon0,
+                                                      double lat1, double lon1,
+                                                      Ellipsoid* ellipsoid,
+                                                      bool optimize_vertex_cache = false,
+                                                      bool relative_to_center = false);
+
+    /// Remplit `arrays` (format Mesh.ARRAY_*) en une seule passe. Les tableaux packés déjà
+    /// présents et à la bonne taille sont réutilisés : en rappelant la fonction avec le même
+    /// `arrays` pour des tuiles de même taille, aucune allocation n'a lieu.
+    /// Si `origin` (x, y, z en double) est fourni, les positions lui sont relatives.
+    static godot::Error build_mesh_arrays(const godot::PackedFloat32Array& heights,
+                                          int n,
+                                          double lat0, double lon0,
+                                          double lat1, double lon1,
+                                          Ellipsoid* ellipsoid,
+                                          godot::Array arrays,
+                                          bool optimize_vertex_cache = false,
+                                          const godot::PackedFloat64Array& origin = godot::PackedFloat64Array());
+
+    /// Normales de la tuile (même calcul que build_mesh) encodées en octaèdre dans une
+    /// image n×n FORMAT_RG8, pour un échantillonnage dans le shader plutôt que par sommet.
+    static godot::Ref<godot::Image> build_normal_texture(const godot::PackedFloat32Array& heights,
+                                                         int n,
+                                                         double lat0, double lon0,
+                                                         double lat1, double lon1,
+                                                         Ellipsoid* ellipsoid);
+
+    /// Origine RTC d'une tuile : centre géodésique à l'altitude 0, en double.
+    static godot::PackedFloat64Array compute_tile_origin(double lat0, double lon0,
+                                                         double lat1, double lon1,
+                                                         Ellipsoid* ellipsoid);
                                                    
 protected:
     static void _bind_methods();
 
+private:
+    // Cœur de build_mesh_arrays, sans accès au nœud Ellipsoid (appelable depuis un worker)
+    static godot::Error fill_arrays(const godot::PackedFloat32Array& heights,
+                                    int n,
+                                    double lat0, double lon0,
+                                    double lat1, double lon1,
+                                    const godot::Vector3& axis,
+                                    godot::Array arrays,
+                                    bool optimize_vertex_cache,
+                                    const godot::PackedFloat64Array& origin);
 };
@@ -0,0 +1,45 @@
+#include "IcosahedronTessellator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace godot;
+
+IcosahedronTessellator::IcosahedronTessellator() {}
+IcosahedronTessellator::~IcosahedronTessellator() {}
+
+void IcosahedronTessellator::_bind_methods() {
+}
+
+bool IcosahedronTessellator::generate(int subdivisions, real_t radius, PackedVector3Array &vertices, PackedInt32Array &indices) {
+    ERR_FAIL_COND_V(subdivisions < 0 || subdivisions > MAX_SUBDIVISIONS, false);
+
+    // Final sizes for an icosahedron: F = 20 * 4^n, V = F / 2 + 2
+    const int64_t face_count = int64_t(20) << (2 * subdivisions);
+    vertices.resize(face_count / 2 + 2);
+
+    // Three orthogonal golden rectangles
+    const real_t t = (1.0 + std::sqrt(5.0)) * 0.5;
+    const Vector3 corners[12] = {
+        Vector3(-1, t, 0), Vector3(1, t, 0), Vector3(-1, -t, 0), Vector3(1, -t, 0),
+        Vector3(0, -1, t), Vector3(0, 1, t), Vector3(0, -1, -t), Vector3(0, 1, -t),
+        Vector3(t, 0, -1), Vector3(t, 0, 1), Vector3(-t, 0, -1), Vector3(-t, 0, 1),
+    };
+    Vector3 *v = vertices.ptrw();
+    for (int i = 0; i < 12; ++i) {
+        v[i] = corners[i].normalized() * radius;
+    }
+
+    // Same winding as TetrahedronTessellator: (b - a) x (c - a) points outward
+    static const int32_t faces[60] = {
+        0, 11, 5,  0, 5, 1,   0, 1, 7,   0, 7, 10,  0, 10, 11,
+        1, 5, 9,   5, 11, 4,  11, 10, 2, 10, 7, 6,  7, 1, 8,
+        3, 9, 4,   3, 4, 2,   3, 2, 6,   3, 6, 8,   3, 8, 9,
+        4, 9, 5,   2, 4, 11,  6, 2, 10,  8, 6, 7,   9, 8, 1,
+    };
+    indices.resize(60);
+    std::copy(faces, faces + 60, indices.ptrw());
+
+    subdivide_on_sphere(vertices, 12, indices, subdivisions, radius);
+    return true;
+}
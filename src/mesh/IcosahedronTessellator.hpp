@@ -0,0 +1,23 @@
+#pragma once
+
+#include "AbstractTessellator.hpp"
+
+using namespace godot;
+
+// Subdivided icosahedron: 20 * 4^n nearly equal triangles (largest / smallest area < 1.3 at any level,
+// against > 6 for the tetrahedron)
+class IcosahedronTessellator : public AbstractTessellator {
+    GDCLASS(IcosahedronTessellator, AbstractTessellator);
+
+protected:
+    static void _bind_methods();
+
+public:
+    IcosahedronTessellator();
+    ~IcosahedronTessellator();
+
+    static constexpr int MAX_SUBDIVISIONS = 11;
+
+protected:
+    bool generate(int subdivisions, real_t radius, PackedVector3Array &vertices, PackedInt32Array &indices) override;
+};
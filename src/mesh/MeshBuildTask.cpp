@@ -0,0 +1,70 @@
+#include "MeshBuildTask.hpp"
+
+#include <godot_cpp/classes/mesh.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+
+using namespace godot;
+
+MeshBuildTask::MeshBuildTask() {}
+
+MeshBuildTask::~MeshBuildTask() {
+    // Every pool task must be waited for, and the worker still points at this object
+    wait();
+}
+
+void MeshBuildTask::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("is_completed"), &MeshBuildTask::is_completed);
+    ClassDB::bind_method(D_METHOD("wait"), &MeshBuildTask::wait);
+    ClassDB::bind_method(D_METHOD("get_arrays"), &MeshBuildTask::get_arrays);
+    ClassDB::bind_method(D_METHOD("commit"), &MeshBuildTask::commit);
+}
+
+Ref<MeshBuildTask> MeshBuildTask::start(BuildFunc func, const String &description, const Dictionary &meta, uint64_t format_flags) {
+    Ref<MeshBuildTask> task;
+    task.instantiate();
+    task->func = std::move(func);
+    task->meta = meta;
+    task->format_flags = format_flags;
+    task->task_id = WorkerThreadPool::get_singleton()->add_task(callable_mp(task.ptr(), &MeshBuildTask::_run), false, description);
+    return task;
+}
+
+void MeshBuildTask::_run() {
+    // Worker thread: only plain arrays are touched here, never the ArrayMesh or the RenderingServer
+    arrays = func();
+}
+
+bool MeshBuildTask::is_completed() const {
+    return waited || task_id < 0 || WorkerThreadPool::get_singleton()->is_task_completed(task_id);
+}
+
+void MeshBuildTask::wait() {
+    if (waited || task_id < 0) return;
+    WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+    waited = true;
+    func = nullptr;
+}
+
+Array MeshBuildTask::get_arrays() {
+    wait();
+    return arrays;
+}
+
+Ref<ArrayMesh> MeshBuildTask::commit() {
+    wait();
+    if (mesh.is_valid()) return mesh;
+    if (arrays.size() != Mesh::ARRAY_MAX) return mesh;
+
+    const PackedVector3Array vertices = arrays[Mesh::ARRAY_VERTEX];
+    ERR_FAIL_COND_V_MSG(vertices.is_empty(), mesh, "MeshBuildTask produced no vertices.");
+
+    mesh.instantiate();
+    mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays, TypedArray<Array>(), Dictionary(), format_flags);
+    const Array keys = meta.keys();
+    for (int i = 0; i < keys.size(); ++i) {
+        mesh->set_meta(keys[i], meta[keys[i]]);
+    }
+    return mesh;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <godot_cpp/classes/array_mesh.hpp>
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+#include <cstdint>
+#include <functional>
+
+using namespace godot;
+
+/// Mesh generation running on the WorkerThreadPool.
+/// The worker only fills the Mesh arrays (vertex/index buffers); the ArrayMesh is created
+/// in commit(), which must be called from the main thread and is cheap (a single upload).
+class MeshBuildTask : public RefCounted {
+    GDCLASS(MeshBuildTask, RefCounted);
+
+protected:
+    static void _bind_methods();
+
+public:
+    using BuildFunc = std::function<Array()>;
+
+    MeshBuildTask();
+    ~MeshBuildTask();
+
+    // Queue `func` on the WorkerThreadPool. `meta` is copied onto the mesh at commit time,
+    // `format_flags` (Mesh.ARRAY_FORMAT_*, e.g. custom channel formats) go to add_surface_from_arrays.
+    static Ref<MeshBuildTask> start(BuildFunc func, const String &description, const Dictionary &meta = Dictionary(),
+                                    uint64_t format_flags = 0);
+
+    bool is_completed() const;
+    void wait();
+    // Mesh arrays produced by the worker (waits for completion)
+    Array get_arrays();
+    // Create the ArrayMesh from the worker's arrays (main thread, waits for completion)
+    Ref<ArrayMesh> commit();
+
+private:
+    BuildFunc func;
+    Array arrays;
+    Dictionary meta;
+    uint64_t format_flags = 0;
+    Ref<ArrayMesh> mesh;
+    int64_t task_id = -1;
+    bool waited = false;
+
+    void _run();
+};
@@ -0,0 +1,417 @@
+#include "PolylineMeshBuilder.hpp"
+
+#include "data_sources/vector_geometry_buffer.hpp"
+#include "math/Ellipsoid.hpp"
+#include "math/ParallelFor.hpp"
+
+#include <godot_cpp/classes/mesh.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr int64_t DRAPE_GRAIN = 4096;
+
+struct Vec {
+    double x, y, z;
+    Vec operator+(const Vec &o) const { return { x + o.x, y + o.y, z + o.z }; }
+    Vec operator-(const Vec &o) const { return { x - o.x, y - o.y, z - o.z }; }
+    Vec operator*(double s) const { return { x * s, y * s, z * s }; }
+    double dot(const Vec &o) const { return x * o.x + y * o.y + z * o.z; }
+    Vec cross(const Vec &o) const { return { y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x }; }
+    double length() const { return std::sqrt(dot(*this)); }
+    Vec normalized() const {
+        const double l = length();
+        return l > 0.0 ? *this * (1.0 / l) : Vec{ 0.0, 0.0, 0.0 };
+    }
+};
+
+// Output buffers, two vertices (left, right) per emitted pair
+struct LineWriter {
+    GrowablePacked<PackedVector3Array, Vector3> vertices;
+    GrowablePacked<PackedVector3Array, Vector3> normals;
+    GrowablePacked<PackedVector2Array, Vector2> uvs;
+    GrowablePacked<PackedFloat32Array, float> extrusions; // 3 per vertex
+    GrowablePacked<PackedFloat32Array, float> ids;
+    GrowablePacked<PackedInt32Array, int32_t> indices;
+    const double *origin = nullptr;
+
+    // Left vertex at side + along, right vertex at -side + along (along: square cap extension)
+    int32_t emit_pair(const Vec &p, const Vec &up, const Vec &side, double distance, float id, const Vec &along = Vec{ 0.0, 0.0, 0.0 }) {
+        const int32_t first = int32_t(vertices.size());
+        const Vector3 position(real_t(p.x - origin[0]), real_t(p.y - origin[1]), real_t(p.z - origin[2]));
+        const Vector3 normal(real_t(up.x), real_t(up.y), real_t(up.z));
+        for (int k = 0; k < 2; ++k) {
+            const double sign = k == 0 ? 1.0 : -1.0;
+            vertices.push_back(position);
+            normals.push_back(normal);
+            uvs.push_back(Vector2(real_t(distance), real_t(sign)));
+            float *x = extrusions.grow(3);
+            x[0] = float(side.x * sign + along.x);
+            x[1] = float(side.y * sign + along.y);
+            x[2] = float(side.z * sign + along.z);
+            ids.push_back(id);
+        }
+        return first;
+    }
+
+    // Quad between two pairs; (b - a) x (c - a) along the normal for a straight segment
+    void connect(int32_t a, int32_t b) {
+        int32_t *i = indices.grow(6);
+        i[0] = a;     i[1] = a + 1; i[2] = b;
+        i[3] = a + 1; i[4] = b + 1; i[5] = b;
+    }
+};
+
+} // namespace
+
+void PolylineMeshBuilder::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_cap_style", "cap"), &PolylineMeshBuilder::set_cap_style);
+    ClassDB::bind_method(D_METHOD("get_cap_style"), &PolylineMeshBuilder::get_cap_style);
+    ClassDB::bind_method(D_METHOD("set_miter_limit", "limit"), &PolylineMeshBuilder::set_miter_limit);
+    ClassDB::bind_method(D_METHOD("get_miter_limit"), &PolylineMeshBuilder::get_miter_limit);
+    ClassDB::bind_method(D_METHOD("set_altitude", "altitude"), &PolylineMeshBuilder::set_altitude);
+    ClassDB::bind_method(D_METHOD("get_altitude"), &PolylineMeshBuilder::get_altitude);
+    ClassDB::bind_method(D_METHOD("set_include_rings", "enable"), &PolylineMeshBuilder::set_include_rings);
+    ClassDB::bind_method(D_METHOD("get_include_rings"), &PolylineMeshBuilder::get_include_rings);
+    ClassDB::bind_method(D_METHOD("set_relative_to_center", "enable"), &PolylineMeshBuilder::set_relative_to_center);
+    ClassDB::bind_method(D_METHOD("get_relative_to_center"), &PolylineMeshBuilder::get_relative_to_center);
+
+    ClassDB::bind_method(D_METHOD("build_arrays", "geometries", "ellipsoid"), &PolylineMeshBuilder::build_arrays, DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("build_mesh", "geometries", "ellipsoid"), &PolylineMeshBuilder::build_mesh, DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("build_mesh_async", "geometries", "ellipsoid"), &PolylineMeshBuilder::build_mesh_async, DEFVAL(Variant()));
+    ClassDB::bind_method(D_METHOD("build_mesh_from_paths", "paths", "ellipsoid"), &PolylineMeshBuilder::build_mesh_from_paths, DEFVAL(Variant()));
+    ClassDB::bind_static_method("PolylineMeshBuilder", D_METHOD("paths_to_geometries", "paths"), &PolylineMeshBuilder::paths_to_geometries);
+    ClassDB::bind_static_method("PolylineMeshBuilder", D_METHOD("get_format_flags"), &PolylineMeshBuilder::get_format_flags);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "cap_style", PROPERTY_HINT_ENUM, "Butt,Square"), "set_cap_style", "get_cap_style");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "miter_limit", PROPERTY_HINT_RANGE, "1,10,0.1"), "set_miter_limit", "get_miter_limit");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "altitude"), "set_altitude", "get_altitude");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "include_rings"), "set_include_rings", "get_include_rings");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "relative_to_center"), "set_relative_to_center", "get_relative_to_center");
+
+    BIND_ENUM_CONSTANT(CAP_BUTT);
+    BIND_ENUM_CONSTANT(CAP_SQUARE);
+}
+
+void PolylineMeshBuilder::set_cap_style(CapStyle cap) {
+    cap_style = cap;
+}
+
+void PolylineMeshBuilder::set_miter_limit(double limit) {
+    miter_limit = MAX(limit, 1.0);
+}
+
+void PolylineMeshBuilder::set_altitude(double p_altitude) {
+    altitude = p_altitude;
+}
+
+void PolylineMeshBuilder::set_include_rings(bool enable) {
+    include_rings = enable;
+}
+
+void PolylineMeshBuilder::set_relative_to_center(bool enable) {
+    relative_to_center = enable;
+}
+
+int64_t PolylineMeshBuilder::get_format_flags() {
+    return (int64_t(Mesh::ARRAY_CUSTOM_RGB_FLOAT) << Mesh::ARRAY_FORMAT_CUSTOM0_SHIFT) |
+           (int64_t(Mesh::ARRAY_CUSTOM_R_FLOAT) << Mesh::ARRAY_FORMAT_CUSTOM1_SHIFT);
+}
+
+PolylineMeshBuilder::Settings PolylineMeshBuilder::make_settings(const Dictionary &geometries, Ellipsoid *ellipsoid) const {
+    Settings s;
+    s.drape = ellipsoid != nullptr;
+    if (ellipsoid) {
+        s.a = ellipsoid->get_axis().x;
+        s.e2 = ellipsoid->get_eccentricity_squared();
+    }
+    s.altitude = altitude;
+    s.cap = cap_style;
+    s.miter_limit = miter_limit;
+    s.include_rings = include_rings;
+    s.relative = relative_to_center;
+
+    if (relative_to_center) {
+        // Centre of the coordinate bounds, on the ellipsoid when draped
+        const PackedFloat64Array coords = geometries.get("coords", PackedFloat64Array());
+        if (coords.size() >= 2) {
+            double min_x = coords[0], min_y = coords[1], max_x = coords[0], max_y = coords[1];
+            for (int64_t i = 2; i + 1 < coords.size(); i += 2) {
+                min_x = MIN(min_x, coords[i]);
+                max_x = MAX(max_x, coords[i]);
+                min_y = MIN(min_y, coords[i + 1]);
+                max_y = MAX(max_y, coords[i + 1]);
+            }
+            const double cx = 0.5 * (min_x + max_x);
+            const double cy = 0.5 * (min_y + max_y);
+            if (s.drape) {
+                Ellipsoid::geodetic_to_3d_batch(s.a, s.e2, &cy, &cx, &s.altitude, 1, s.origin);
+            } else {
+                s.origin[0] = cx;
+                s.origin[1] = cy;
+            }
+        }
+    }
+    return s;
+}
+
+Dictionary PolylineMeshBuilder::origin_meta(const Settings &settings) {
+    Dictionary meta;
+    if (settings.relative) {
+        PackedFloat64Array origin;
+        origin.resize(3);
+        origin.set(0, settings.origin[0]);
+        origin.set(1, settings.origin[1]);
+        origin.set(2, settings.origin[2]);
+        meta["rtc_origin"] = origin;
+    }
+    return meta;
+}
+
+Array PolylineMeshBuilder::fill_arrays(const Dictionary &geometries, const Settings &s) {
+    const PackedFloat64Array coords = geometries.get("coords", PackedFloat64Array());
+    const PackedInt32Array part_offsets = geometries.get("part_offsets", PackedInt32Array());
+    const PackedByteArray part_kinds = geometries.get("part_kinds", PackedByteArray());
+    const PackedInt32Array feature_offsets = geometries.get("feature_offsets", PackedInt32Array());
+    const PackedInt32Array source_features = geometries.get("source_features", PackedInt32Array());
+    ERR_FAIL_COND_V_MSG(feature_offsets.is_empty() || part_offsets.is_empty() || part_kinds.size() != part_offsets.size() - 1,
+            Array(), "Expected the output of VectorSource.load_geometries");
+
+    const int64_t vertex_count = coords.size() / 2;
+    const double *xy = coords.ptr();
+
+    // Centreline points and surface normals in double, in one batch when draped
+    std::vector<double> positions(vertex_count * 3);
+    std::vector<double> ups(vertex_count * 3);
+    if (s.drape) {
+        std::vector<double> lat(vertex_count), lon(vertex_count);
+        for (int64_t i = 0; i < vertex_count; ++i) {
+            lon[i] = xy[i * 2];
+            lat[i] = xy[i * 2 + 1];
+        }
+        const std::vector<double> alt(s.altitude != 0.0 ? vertex_count : 0, s.altitude);
+        parallel_for(vertex_count, DRAPE_GRAIN, [&](int64_t begin, int64_t end) {
+            Ellipsoid::geodetic_to_3d_batch(s.a, s.e2, lat.data() + begin, lon.data() + begin,
+                                            alt.empty() ? nullptr : alt.data() + begin, end - begin, positions.data() + begin * 3);
+            // Geodetic normal, same frame as geodetic_to_3d (polar axis on y, lon' = lon - 90°)
+            for (int64_t i = begin; i < end; ++i) {
+                const double rad_lat = lat[i] * (Math_PI / 180.0);
+                const double rad_lon = lon[i] * (Math_PI / 180.0) - Math_PI / 2.0;
+                ups[i * 3] = std::cos(rad_lat) * std::cos(rad_lon);
+                ups[i * 3 + 1] = std::sin(rad_lat);
+                ups[i * 3 + 2] = std::cos(rad_lat) * std::sin(rad_lon);
+            }
+        });
+    } else {
+        for (int64_t i = 0; i < vertex_count; ++i) {
+            positions[i * 3] = xy[i * 2];
+            positions[i * 3 + 1] = xy[i * 2 + 1];
+            positions[i * 3 + 2] = 0.0;
+            ups[i * 3] = 0.0;
+            ups[i * 3 + 1] = 0.0;
+            ups[i * 3 + 2] = 1.0;
+        }
+    }
+    auto P = [&](int64_t i) { return Vec{ positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2] }; };
+    auto U = [&](int64_t i) { return Vec{ ups[i * 3], ups[i * 3 + 1], ups[i * 3 + 2] }; };
+
+    LineWriter w;
+    w.origin = s.origin;
+    const int64_t estimate = (vertex_count + part_kinds.size()) * 2;
+    w.vertices.reserve(estimate);
+    w.normals.reserve(estimate);
+    w.uvs.reserve(estimate);
+    w.extrusions.reserve(estimate * 3);
+    w.ids.reserve(estimate);
+    w.indices.reserve(vertex_count * 6);
+
+    const int32_t *parts = part_offsets.ptr();
+    const uint8_t *kinds = part_kinds.ptr();
+    const int32_t *features = feature_offsets.ptr();
+    const int64_t feature_count = feature_offsets.size() - 1;
+    std::vector<int64_t> pts;
+    std::vector<Vec> sides; // left normal of each segment
+
+    for (int64_t f = 0; f < feature_count; ++f) {
+        const float id = float(f < source_features.size() ? source_features[f] : f);
+        for (int32_t p = features[f]; p < features[f + 1]; ++p) {
+            const uint8_t kind = kinds[p];
+            const bool ring = kind == VectorGeometryBuffer::PART_EXTERIOR_RING || kind == VectorGeometryBuffer::PART_INTERIOR_RING;
+            if (kind != VectorGeometryBuffer::PART_LINE && !(ring && s.include_rings)) {
+                continue;
+            }
+
+            // Distinct consecutive points; a part ending on its first point is a closed loop
+            pts.clear();
+            for (int64_t i = parts[p]; i < parts[p + 1]; ++i) {
+                if (pts.empty() || xy[i * 2] != xy[pts.back() * 2] || xy[i * 2 + 1] != xy[pts.back() * 2 + 1]) {
+                    pts.push_back(i);
+                }
+            }
+            bool closed = false;
+            if (pts.size() >= 4 && xy[pts.front() * 2] == xy[pts.back() * 2] && xy[pts.front() * 2 + 1] == xy[pts.back() * 2 + 1]) {
+                pts.pop_back();
+                closed = true;
+            }
+            const int64_t m = int64_t(pts.size());
+            if (m < 2) {
+                continue;
+            }
+            const int64_t segments = closed ? m : m - 1;
+            sides.resize(segments);
+            for (int64_t k = 0; k < segments; ++k) {
+                const int64_t a = pts[k];
+                const int64_t b = pts[(k + 1) % m];
+                const Vec up = (U(a) + U(b)).normalized();
+                sides[k] = up.cross(P(b) - P(a)).normalized();
+            }
+
+            double distance = 0.0;
+            int32_t last_pair = -1;
+            int32_t first_pair = -1;
+            for (int64_t k = 0; k < m; ++k) {
+                const int64_t v = pts[k];
+                const Vec pos = P(v);
+                const Vec up = U(v);
+                if (k > 0) {
+                    distance += (pos - P(pts[k - 1])).length();
+                }
+                const bool has_prev = closed || k > 0;
+                const bool has_next = closed || k < m - 1;
+                int32_t in_pair, out_pair;
+                if (!has_prev || !has_next) {
+                    // Open end: butt, or square (extended by half a width along the segment)
+                    const Vec side = has_next ? sides[k] : sides[k - 1];
+                    Vec along{ 0.0, 0.0, 0.0 };
+                    if (s.cap == CAP_SQUARE) {
+                        // Outwards on both vertices: backwards at the start, forwards at the end
+                        const Vec direction = up.cross(side).normalized() * -1.0;
+                        along = direction * (has_next ? -1.0 : 1.0);
+                    }
+                    in_pair = out_pair = w.emit_pair(pos, up, side, distance, id, along);
+                } else {
+                    const Vec n0 = sides[(k + segments - 1) % segments];
+                    const Vec n1 = sides[k];
+                    const Vec sum = n0 + n1;
+                    const double len = sum.length();
+                    const Vec miter = len > 1e-9 ? sum * (1.0 / len) : n1;
+                    const double cos_half = miter.dot(n1);
+                    if (len > 1e-9 && cos_half >= 1.0 / s.miter_limit) {
+                        in_pair = out_pair = w.emit_pair(pos, up, miter * (1.0 / cos_half), distance, id);
+                    } else {
+                        // Bevel: the quad between both pairs closes the outer wedge
+                        in_pair = w.emit_pair(pos, up, n0, distance, id);
+                        out_pair = w.emit_pair(pos, up, n1, distance, id);
+                        w.connect(in_pair, out_pair);
+                    }
+                }
+                if (last_pair >= 0) {
+                    w.connect(last_pair, in_pair);
+                }
+                if (k == 0) {
+                    first_pair = in_pair;
+                }
+                last_pair = out_pair;
+            }
+            if (closed) {
+                // Back to the first point, with the incoming side of its join and the full length
+                // (a closed loop has no cap: the left extrusion of the first pair is its side)
+                distance += (P(pts[0]) - P(pts[m - 1])).length();
+                const Vec pos = P(pts[0]);
+                const Vec up = U(pts[0]);
+                const float *e = &w.extrusions.ptr()[int64_t(first_pair) * 3];
+                const int32_t end_pair = w.emit_pair(pos, up, Vec{ e[0], e[1], e[2] }, distance, id);
+                w.connect(last_pair, end_pair);
+            }
+        }
+    }
+
+    if (w.vertices.size() == 0) {
+        return Array();
+    }
+    Array arrays;
+    arrays.resize(Mesh::ARRAY_MAX);
+    arrays[Mesh::ARRAY_VERTEX] = w.vertices.finish();
+    arrays[Mesh::ARRAY_NORMAL] = w.normals.finish();
+    arrays[Mesh::ARRAY_TEX_UV] = w.uvs.finish();
+    arrays[Mesh::ARRAY_CUSTOM0] = w.extrusions.finish();
+    arrays[Mesh::ARRAY_CUSTOM1] = w.ids.finish();
+    arrays[Mesh::ARRAY_INDEX] = w.indices.finish();
+    return arrays;
+}
+
+Array PolylineMeshBuilder::build_arrays(const Dictionary &geometries, Ellipsoid *ellipsoid) const {
+    return fill_arrays(geometries, make_settings(geometries, ellipsoid));
+}
+
+Ref<ArrayMesh> PolylineMeshBuilder::build_mesh(const Dictionary &geometries, Ellipsoid *ellipsoid) const {
+    const Settings settings = make_settings(geometries, ellipsoid);
+    const Array arrays = fill_arrays(geometries, settings);
+    Ref<ArrayMesh> mesh;
+    mesh.instantiate();
+    if (arrays.size() == Mesh::ARRAY_MAX) {
+        mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays, TypedArray<Array>(), Dictionary(), get_format_flags());
+    }
+    const Dictionary meta = origin_meta(settings);
+    if (meta.has("rtc_origin")) {
+        mesh->set_meta("rtc_origin", meta["rtc_origin"]);
+    }
+    return mesh;
+}
+
+Ref<MeshBuildTask> PolylineMeshBuilder::build_mesh_async(const Dictionary &geometries, Ellipsoid *ellipsoid) const {
+    // The Ellipsoid node and the builder properties are read here; the worker gets copies
+    const Settings settings = make_settings(geometries, ellipsoid);
+    return MeshBuildTask::start([=]() {
+        return fill_arrays(geometries, settings);
+    }, "PolylineMeshBuilder::build_mesh_async", origin_meta(settings), uint64_t(get_format_flags()));
+}
+
+Ref<ArrayMesh> PolylineMeshBuilder::build_mesh_from_paths(const Array &paths, Ellipsoid *ellipsoid) const {
+    return build_mesh(paths_to_geometries(paths), ellipsoid);
+}
+
+Dictionary PolylineMeshBuilder::paths_to_geometries(const Array &paths) {
+    int64_t total = 0;
+    for (int64_t i = 0; i < paths.size(); ++i) {
+        const PackedVector2Array path = paths[i];
+        total += path.size();
+    }
+    PackedFloat64Array coords;
+    PackedInt32Array part_offsets;
+    PackedByteArray part_kinds;
+    PackedInt32Array feature_offsets;
+    coords.resize(total * 2);
+    part_offsets.resize(paths.size() + 1);
+    part_kinds.resize(paths.size());
+    feature_offsets.resize(paths.size() + 1);
+
+    double *xy = coords.ptrw();
+    int32_t *parts = part_offsets.ptrw();
+    int32_t *features = feature_offsets.ptrw();
+    int64_t v = 0;
+    for (int64_t i = 0; i < paths.size(); ++i) {
+        const PackedVector2Array path = paths[i];
+        parts[i] = int32_t(v);
+        features[i] = int32_t(i);
+        for (int64_t k = 0; k < path.size(); ++k, ++v) {
+            xy[v * 2] = path[k].x;
+            xy[v * 2 + 1] = path[k].y;
+        }
+    }
+    parts[paths.size()] = int32_t(v);
+    features[paths.size()] = int32_t(paths.size());
+    part_kinds.fill(VectorGeometryBuffer::PART_LINE);
+
+    Dictionary d;
+    d["coords"] = coords;
+    d["part_offsets"] = part_offsets;
+    d["part_kinds"] = part_kinds;
+    d["feature_offsets"] = feature_offsets;
+    return d;
+}
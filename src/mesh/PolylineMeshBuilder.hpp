@@ -0,0 +1,98 @@
+#pragma once
+
+#include <godot_cpp/classes/array_mesh.hpp>
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+
+#include "MeshBuildTask.hpp"
+
+#include <cstdint>
+
+using namespace godot;
+
+class Ellipsoid;
+
+// Line tessellation for whole vector layers: every line (and ring outline) of a load_geometries
+// result, a VectorTiler tile or load_paths output goes into a single indexed triangle surface,
+// two vertices per centreline point, so a layer is one draw call. The width is applied in the
+// vertex shader, in pixels, from the extrusion attribute:
+// - VERTEX   centreline point: (x, y, 0) in source units, or lon / lat draped on the ellipsoid
+// - NORMAL   (0, 0, 1), or the geodetic normal when draped
+// - UV       (distance along the part, side +1 / -1)
+// - CUSTOM0  RGB_FLOAT extrusion for a half width of 1, miter and square cap included:
+//            VERTEX += CUSTOM0.xyz * half_width_px * world size of a pixel at the vertex depth
+// - CUSTOM1  R_FLOAT feature id: "source_features" when present, else the feature index
+//            (exact below 2^24)
+// Joins are mitred up to miter_limit and bevelled beyond; the bevel faces are not oriented,
+// draw with cull_disabled. Open parts end with butt or square caps.
+class PolylineMeshBuilder : public RefCounted {
+    GDCLASS(PolylineMeshBuilder, RefCounted);
+
+protected:
+    static void _bind_methods();
+
+public:
+    enum CapStyle {
+        CAP_BUTT = 0,
+        CAP_SQUARE = 1,
+    };
+
+    void set_cap_style(CapStyle cap);
+    CapStyle get_cap_style() const { return cap_style; }
+    // Miter length / half width beyond which a join is bevelled
+    void set_miter_limit(double limit);
+    double get_miter_limit() const { return miter_limit; }
+    // Height above the ellipsoid of draped lines (m)
+    void set_altitude(double altitude);
+    double get_altitude() const { return altitude; }
+    // Outline polygon rings too (otherwise only line parts)
+    void set_include_rings(bool enable);
+    bool get_include_rings() const { return include_rings; }
+    // Vertices relative to the centre of the layer (computed in double), the origin is stored
+    // in meta "rtc_origin" as for HeightmapTessellator (cf. FloatingOrigin)
+    void set_relative_to_center(bool enable);
+    bool get_relative_to_center() const { return relative_to_center; }
+
+    // `ellipsoid` null: planar, coordinates used as they are
+    Array build_arrays(const Dictionary &geometries, Ellipsoid *ellipsoid = nullptr) const;
+    Ref<ArrayMesh> build_mesh(const Dictionary &geometries, Ellipsoid *ellipsoid = nullptr) const;
+    // Same mesh, tessellated on the WorkerThreadPool (cf. MeshBuildTask)
+    Ref<MeshBuildTask> build_mesh_async(const Dictionary &geometries, Ellipsoid *ellipsoid = nullptr) const;
+    Ref<ArrayMesh> build_mesh_from_paths(const Array &paths, Ellipsoid *ellipsoid = nullptr) const;
+
+    // load_paths output (Array of PackedVector2Array) in the load_geometries layout
+    static Dictionary paths_to_geometries(const Array &paths);
+    // Flags to pass to add_surface_from_arrays with the arrays of build_arrays
+    static int64_t get_format_flags();
+
+private:
+    CapStyle cap_style = CAP_BUTT;
+    double miter_limit = 2.0;
+    double altitude = 0.0;
+    bool include_rings = true;
+    bool relative_to_center = false;
+
+    // Everything the tessellation needs, copied from the builder and the Ellipsoid node on the
+    // calling thread so that it can run on a worker
+    struct Settings {
+        bool drape = false;
+        double a = 1.0;
+        double e2 = 0.0;
+        double altitude = 0.0;
+        CapStyle cap = CAP_BUTT;
+        double miter_limit = 2.0;
+        bool include_rings = true;
+        bool relative = false;
+        double origin[3] = { 0.0, 0.0, 0.0 };
+    };
+
+    Settings make_settings(const Dictionary &geometries, Ellipsoid *ellipsoid) const;
+    static Array fill_arrays(const Dictionary &geometries, const Settings &settings);
+    static Dictionary origin_meta(const Settings &settings);
+};
+
+VARIANT_ENUM_CAST(PolylineMeshBuilder::CapStyle);
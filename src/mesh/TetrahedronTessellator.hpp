@@ -2,7 +2,6 @@
 
 #include "AbstractTessellator.hpp"
 #include <godot_cpp/variant/packed_vector3_array.hpp>
-#include <vector>
 
 using namespace godot;
 
@@ -16,9 +15,12 @@ public:
     TetrahedronTessellator();
     ~TetrahedronTessellator();
 
-    Dictionary create_mesh(int subdivisions, real_t radius) override;
+    // 2 * 4^12 + 2 vertices (~33 M), already past what a single surface should hold
+    static constexpr int MAX_SUBDIVISIONS = 12;
+
+protected:
+    bool generate(int subdivisions, real_t radius, PackedVector3Array &vertices, PackedInt32Array &indices) override;
 
 private:
-    void subdivide_triangle(const Vector3 &a, const Vector3 &b, const Vector3 &c, int depth, real_t radius, std::vector<Vector3> &vertices, std::vector<int> &indices);
     Vector3 normalize_to_radius(const Vector3 &v, real_t radius);
 };
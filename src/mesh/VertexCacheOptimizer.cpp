@@ -0,0 +1,208 @@
+#include "VertexCacheOptimizer.hpp"
+
+#include <godot_cpp/classes/mesh.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace godot;
+
+void VertexCacheOptimizer::_bind_methods() {
+    ClassDB::bind_static_method("VertexCacheOptimizer", D_METHOD("optimize_indices", "indices", "vertex_count"), &VertexCacheOptimizer::optimize_indices);
+    ClassDB::bind_static_method("VertexCacheOptimizer", D_METHOD("compute_acmr", "indices", "vertex_count", "cache_size"), &VertexCacheOptimizer::compute_acmr, DEFVAL(DEFAULT_CACHE_SIZE));
+    ClassDB::bind_static_method("VertexCacheOptimizer", D_METHOD("compute_mesh_acmr", "mesh", "surface", "cache_size"), &VertexCacheOptimizer::compute_mesh_acmr, DEFVAL(0), DEFVAL(DEFAULT_CACHE_SIZE));
+}
+
+namespace {
+
+// Scoring constants from the original article
+constexpr int kSimCacheSize = 32;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+
+float vertex_score(int cache_pos, int remaining) {
+    if (remaining == 0) {
+        return -1.0f; // no triangle left, never picked again
+    }
+    float score = 0.0f;
+    if (cache_pos >= 0) {
+        if (cache_pos < 3) {
+            // used by the last triangle: fixed score so the strip does not fold back on itself
+            score = kLastTriScore;
+        } else {
+            const float scaler = 1.0f / (kSimCacheSize - 3);
+            score = std::pow(1.0f - (cache_pos - 3) * scaler, kCacheDecayPower);
+        }
+    }
+    // favour vertices with few triangles left so they leave the working set quickly
+    score += kValenceBoostScale * std::pow((float)remaining, -kValenceBoostPower);
+    return score;
+}
+
+} // namespace
+
+void VertexCacheOptimizer::optimize(int32_t *indices, int64_t index_count, int vertex_count) {
+    const int64_t tri_count = index_count / 3;
+    if (tri_count < 2 || vertex_count <= 0) {
+        return;
+    }
+
+    // Vertex -> triangles adjacency (CSR)
+    std::vector<int> remaining(vertex_count, 0);
+    for (int64_t i = 0; i < tri_count * 3; ++i) {
+        ERR_FAIL_INDEX(indices[i], vertex_count);
+        remaining[indices[i]]++;
+    }
+    std::vector<int64_t> offset(vertex_count + 1, 0);
+    for (int v = 0; v < vertex_count; ++v) {
+        offset[v + 1] = offset[v] + remaining[v];
+    }
+    std::vector<int64_t> adjacency(tri_count * 3);
+    {
+        std::vector<int64_t> fill(offset.begin(), offset.end() - 1);
+        for (int64_t t = 0; t < tri_count; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                adjacency[fill[indices[t * 3 + k]]++] = t;
+            }
+        }
+    }
+
+    std::vector<int> cache_pos(vertex_count, -1);
+    std::vector<float> score(vertex_count);
+    for (int v = 0; v < vertex_count; ++v) {
+        score[v] = vertex_score(-1, remaining[v]);
+    }
+    std::vector<float> tri_score(tri_count);
+    std::vector<uint8_t> emitted(tri_count, 0);
+
+    int64_t best = 0;
+    for (int64_t t = 0; t < tri_count; ++t) {
+        tri_score[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+        if (tri_score[t] > tri_score[best]) {
+            best = t;
+        }
+    }
+
+    std::vector<int32_t> out(tri_count * 3);
+    int cache[kSimCacheSize + 3];
+    int cache_len = 0;
+    int64_t scan = 0;
+
+    for (int64_t n = 0; n < tri_count; ++n) {
+        if (best < 0) {
+            // nothing reachable from the cache: restart from the first triangle left
+            while (emitted[scan]) {
+                ++scan;
+            }
+            best = scan;
+        }
+
+        const int tri[3] = { indices[best * 3], indices[best * 3 + 1], indices[best * 3 + 2] };
+        out[n * 3 + 0] = tri[0];
+        out[n * 3 + 1] = tri[1];
+        out[n * 3 + 2] = tri[2];
+        emitted[best] = 1;
+
+        for (int k = 0; k < 3; ++k) {
+            const int v = tri[k];
+            int64_t *first = adjacency.data() + offset[v];
+            int64_t *last = first + remaining[v] - 1;
+            for (int64_t *it = first; it <= last; ++it) {
+                if (*it == best) {
+                    *it = *last;
+                    break;
+                }
+            }
+            remaining[v]--;
+        }
+
+        // LRU update: the triangle's vertices move to the front
+        int next_cache[kSimCacheSize + 3];
+        int next_len = 0;
+        for (int k = 0; k < 3; ++k) {
+            next_cache[next_len++] = tri[k];
+        }
+        for (int c = 0; c < cache_len; ++c) {
+            const int v = cache[c];
+            if (v != tri[0] && v != tri[1] && v != tri[2]) {
+                next_cache[next_len++] = v;
+            }
+        }
+
+        for (int c = 0; c < next_len; ++c) {
+            const int v = next_cache[c];
+            cache_pos[v] = (c < kSimCacheSize) ? c : -1;
+            score[v] = vertex_score(cache_pos[v], remaining[v]);
+        }
+
+        // Rescore the triangles touched by the cache and pick the next one among them
+        best = -1;
+        float best_score = -1.0f;
+        for (int c = 0; c < next_len; ++c) {
+            const int v = next_cache[c];
+            const int64_t *adj = adjacency.data() + offset[v];
+            for (int a = 0; a < remaining[v]; ++a) {
+                const int64_t t = adj[a];
+                const float s = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+                tri_score[t] = s;
+                if (s > best_score) {
+                    best_score = s;
+                    best = t;
+                }
+            }
+        }
+
+        cache_len = MIN(next_len, kSimCacheSize);
+        for (int c = 0; c < cache_len; ++c) {
+            cache[c] = next_cache[c];
+        }
+    }
+
+    for (int64_t i = 0; i < tri_count * 3; ++i) {
+        indices[i] = out[i];
+    }
+}
+
+float VertexCacheOptimizer::acmr(const int32_t *indices, int64_t index_count, int vertex_count, int cache_size) {
+    const int64_t tri_count = index_count / 3;
+    if (tri_count == 0 || vertex_count <= 0) {
+        return 0.0f;
+    }
+    cache_size = MAX(1, cache_size);
+
+    // FIFO: a vertex is resident while fewer than cache_size misses happened since it was loaded
+    std::vector<int64_t> loaded_at(vertex_count, INT64_MIN / 2);
+    int64_t misses = 0;
+    for (int64_t i = 0; i < tri_count * 3; ++i) {
+        const int v = indices[i];
+        ERR_FAIL_INDEX_V(v, vertex_count, 0.0f);
+        if (misses - loaded_at[v] >= cache_size) {
+            loaded_at[v] = misses;
+            ++misses;
+        }
+    }
+    return float(double(misses) / double(tri_count));
+}
+
+PackedInt32Array VertexCacheOptimizer::optimize_indices(const PackedInt32Array &indices, int vertex_count) {
+    PackedInt32Array res = indices;
+    optimize(res.ptrw(), res.size(), vertex_count);
+    return res;
+}
+
+float VertexCacheOptimizer::compute_acmr(const PackedInt32Array &indices, int vertex_count, int cache_size) {
+    return acmr(indices.ptr(), indices.size(), vertex_count, cache_size);
+}
+
+float VertexCacheOptimizer::compute_mesh_acmr(const Ref<ArrayMesh> &mesh, int surface, int cache_size) {
+    ERR_FAIL_COND_V(mesh.is_null(), 0.0f);
+    ERR_FAIL_INDEX_V(surface, mesh->get_surface_count(), 0.0f);
+
+    const Array arrays = mesh->surface_get_arrays(surface);
+    const PackedInt32Array indices = arrays[Mesh::ARRAY_INDEX];
+    const int vertex_count = mesh->surface_get_array_len(surface);
+    return acmr(indices.ptr(), indices.size(), vertex_count, cache_size);
+}
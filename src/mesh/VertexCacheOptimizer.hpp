@@ -0,0 +1,34 @@
+#pragma once
+
+#include <godot_cpp/classes/array_mesh.hpp>
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+
+#include <cstdint>
+
+using namespace godot;
+
+/// Reordering of triangle lists for the GPU post-transform vertex cache
+/// (Tom Forsyth, "Linear-Speed Vertex Cache Optimisation").
+/// Only the triangle order changes: vertex buffers and winding are left untouched.
+class VertexCacheOptimizer : public RefCounted {
+    GDCLASS(VertexCacheOptimizer, RefCounted);
+
+protected:
+    static void _bind_methods();
+
+public:
+    static constexpr int DEFAULT_CACHE_SIZE = 32;
+
+    // In-place variants used by the mesh generators
+    static void optimize(int32_t *indices, int64_t index_count, int vertex_count);
+    // Average cache miss ratio (transformed vertices per triangle) with a FIFO cache.
+    // 0.5 is the ideal for a regular grid, 3.0 means no reuse at all.
+    static float acmr(const int32_t *indices, int64_t index_count, int vertex_count, int cache_size = DEFAULT_CACHE_SIZE);
+
+    static PackedInt32Array optimize_indices(const PackedInt32Array &indices, int vertex_count);
+    static float compute_acmr(const PackedInt32Array &indices, int vertex_count, int cache_size = DEFAULT_CACHE_SIZE);
+    static float compute_mesh_acmr(const Ref<ArrayMesh> &mesh, int surface = 0, int cache_size = DEFAULT_CACHE_SIZE);
+};
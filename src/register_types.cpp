@@ -6,13 +6,25 @@
 #include "map2d_control.hpp"
 #include "globe3d.hpp"
 #include "data_sources/vector_source.hpp"
+#include "data_sources/vector_load_task.hpp"
+#include "data_sources/spatial_index.hpp"
+#include "data_sources/line_simplifier.hpp"
+#include "data_sources/vector_tiler.hpp"
 #include "data_sources/raster_source.hpp"
 #include "math/Ellipsoid.hpp"
 #include "math/Geodetic3D.hpp"
+#include "math/GeodeticGroup.hpp"
+#include "math/FloatingOrigin.hpp"
 // Mesh tessellators
 #include "mesh/AbstractTessellator.hpp"
+#include "mesh/CubeSphereTessellator.hpp"
+#include "mesh/GeodeticMultiMesh.hpp"
 #include "mesh/HeightmapTessellator.hpp"
+#include "mesh/IcosahedronTessellator.hpp"
+#include "mesh/MeshBuildTask.hpp"
+#include "mesh/PolylineMeshBuilder.hpp"
 #include "mesh/TetrahedronTessellator.hpp"
+#include "mesh/VertexCacheOptimizer.hpp"
 
 #include "terrain/runtime/mesh/shared_grid.hpp"
 #include "terrain/runtime/lod/quadtree_cpu.hpp"
@@ -35,13 +47,25 @@ static void initialize_module(ModuleInitializationLevel p_level) {
     ClassDB::register_class<Map2DControl>();
     ClassDB::register_class<Globe3D>();
     ClassDB::register_class<VectorSource>();
+    ClassDB::register_class<VectorLoadTask>();
+    ClassDB::register_class<SpatialIndex>();
+    ClassDB::register_class<LineSimplifier>();
+    ClassDB::register_class<VectorTiler>();
     ClassDB::register_class<RasterSource>();
     ClassDB::register_class<Ellipsoid>();
     ClassDB::register_class<Geodetic3D>();
+    ClassDB::register_class<GeodeticGroup>();
+    ClassDB::register_class<FloatingOrigin>();
     // Register tessellators
     ClassDB::register_class<AbstractTessellator>();
     ClassDB::register_class<HeightmapTessellator>();
+    ClassDB::register_class<MeshBuildTask>();
+    ClassDB::register_class<PolylineMeshBuilder>();
     ClassDB::register_class<TetrahedronTessellator>();
+    ClassDB::register_class<IcosahedronTessellator>();
+    ClassDB::register_class<CubeSphereTessellator>();
+    ClassDB::register_class<GeodeticMultiMesh>();
+    ClassDB::register_class<VertexCacheOptimizer>();
 
     g_gis_singleton = memnew(GisSingleton);
     Engine::get_singleton()->register_singleton("Gis", g_gis_singleton);
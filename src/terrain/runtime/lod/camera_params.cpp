@@ -6,6 +6,12 @@ void CameraParams::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get_position"), &CameraParams::get_position);
     ADD_PROPERTY(PropertyInfo(Variant::VECTOR3, "position"), "set_position", "get_position");
 
+    ClassDB::bind_method(D_METHOD("set_globe_position", "globe_position"), &CameraParams::set_globe_position);
+    ClassDB::bind_method(D_METHOD("get_globe_position"), &CameraParams::get_globe_position);
+    ClassDB::bind_method(D_METHOD("has_globe_position"), &CameraParams::has_globe_position);
+    ClassDB::bind_method(D_METHOD("clear_globe_position"), &CameraParams::clear_globe_position);
+    ADD_PROPERTY(PropertyInfo(Variant::VECTOR3, "globe_position"), "set_globe_position", "get_globe_position");
+
     ClassDB::bind_method(D_METHOD("set_fov_y_deg", "fov_y_deg"), &CameraParams::set_fov_y_deg);
     ClassDB::bind_method(D_METHOD("get_fov_y_deg"), &CameraParams::get_fov_y_deg);
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "fov_y_deg"), "set_fov_y_deg", "get_fov_y_deg");
@@ -20,6 +20,13 @@ public:
     void set_viewport_height_px(double h) { viewport_height_px_ = (float)h; }
     double get_viewport_height_px() const { return (double)viewport_height_px_; }
 
+    // Position caméra dans le repère local de l'Ellipsoid (horizon culling de QuadtreeCPU),
+    // distincte de `position` qui est exprimée au-dessus du plan [0..1]²
+    void set_globe_position(const Vector3& p) { globe_position_ = p; has_globe_position_ = true; }
+    Vector3 get_globe_position() const { return globe_position_; }
+    bool has_globe_position() const { return has_globe_position_; }
+    void clear_globe_position() { has_globe_position_ = false; }
+
     void set_forward(const Vector3& f) { forward_ = f; }
     Vector3 get_forward() const { return forward_; }
 
@@ -34,6 +41,8 @@ public:
 
 private:
     Vector3 position_{};
+    Vector3 globe_position_{};
+    bool    has_globe_position_ = false;
     float   fov_y_deg_ = 60.0f;
     float   viewport_height_px_ = 1080.0f;
     Vector3 forward_{0,0,-1};
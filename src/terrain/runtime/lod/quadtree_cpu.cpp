@@ -1,4 +1,5 @@
 #include "quadtree_cpu.hpp"
+#include <godot_cpp/core/object.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <queue>
 #include <cmath>
@@ -82,11 +83,50 @@ void QuadtreeCPU::_bind_methods() {
     ClassDB::bind_method(D_METHOD("set_max_lod", "max_lod"), &QuadtreeCPU::set_max_lod);
     ClassDB::bind_method(D_METHOD("set_screen_error_px", "px"), &QuadtreeCPU::set_screen_error_px);
     ClassDB::bind_method(D_METHOD("build_tile_list", "camera_params"), &QuadtreeCPU::build_tile_list);
+    ClassDB::bind_method(D_METHOD("get_morph_distances", "camera_params"), &QuadtreeCPU::get_morph_distances);
+    ClassDB::bind_method(D_METHOD("set_ellipsoid", "ellipsoid"), &QuadtreeCPU::set_ellipsoid);
+    ClassDB::bind_method(D_METHOD("set_max_terrain_height", "height"), &QuadtreeCPU::set_max_terrain_height);
 }
 
 void QuadtreeCPU::set_max_lod(int max_lod) { max_lod_ = MAX(0, max_lod); }
 void QuadtreeCPU::set_screen_error_px(float px) { target_error_px_ = MAX(0.5f, px); }
 
+void QuadtreeCPU::set_ellipsoid(Ellipsoid* ellipsoid) {
+    ellipsoid_id_ = ellipsoid ? ObjectID(ellipsoid->get_instance_id()) : ObjectID();
+    occluder_cache_.clear();
+}
+
+Ellipsoid* QuadtreeCPU::get_ellipsoid() const {
+    if (ellipsoid_id_.is_null()) return nullptr;
+    return Object::cast_to<Ellipsoid>(ObjectDB::get_instance(ellipsoid_id_));
+}
+
+void QuadtreeCPU::set_max_terrain_height(float h) {
+    max_terrain_height_ = MAX(0.0f, h);
+    occluder_cache_.clear();
+}
+
+bool QuadtreeCPU::is_above_horizon(Ellipsoid* ellipsoid, const TileKey& key, const Vector3& globe_cam_pos) {
+    const Vector3* cached = occluder_cache_.getptr(key);
+    if (!cached) {
+        // coins + milieux des bords + centre de la tuile, à l'altitude max du terrain
+        const double size = 1.0 / double(1 << key.lod);
+        const double u0 = key.ix * size;
+        const double v0 = key.iy * size;
+        PackedVector3Array pts;
+        pts.resize(9);
+        Vector3* w = pts.ptrw();
+        for (int j = 0; j < 3; ++j) for (int i = 0; i < 3; ++i) {
+            const double lon = -180.0 + 360.0 * (u0 + size * 0.5 * i);
+            const double lat =   90.0 - 180.0 * (v0 + size * 0.5 * j);
+            w[j * 3 + i] = ellipsoid->geodetic_to_3d(lat, lon, max_terrain_height_);
+        }
+        const Vector3 occluder = ellipsoid->compute_horizon_culling_point(w[4], pts);
+        cached = &occluder_cache_.insert(key, occluder)->value;
+    }
+    return ellipsoid->is_occluder_point_visible(globe_cam_pos, *cached);
+}
+
 struct QuadTreeNode { int lod; int ix; int iy; float size; Vector2 center; };
 
 static inline float approx_projected_size_px(const Vector3& cam, const Vector2& center, float size) {
@@ -109,14 +149,26 @@ float QuadtreeCPU::compute_morph_factor(
     int lod, const Vector3& cam_pos, float focal_px,
     const Vector2& c, float size_world
 ) const {
-    // Rampe autour du seuil en pixels (±25% par ex.)
+    // Rampe CDLOD entre les seuils de fusion (a * hystérésis) et de découpe (a) de la tuile :
+    // morph = 1 (pleine résolution) exactement quand elle se découpe, et ses enfants, qui
+    // projettent alors ~a/2 < a * hystérésis, naissent à morph = 0 (grille du parent).
     const float s_px = tile_projected_size_px(cam_pos, c, size_world, focal_px);
-    const float a = target_error_px_;
-    const float w = a * 0.25f;
-    const float t = (s_px - (a - w)) / (2.0f * w);
+    const float split_px = target_error_px_;
+    const float merge_px = target_error_px_ * hysteresis_ratio_;
+    const float t = (s_px - merge_px) / (split_px - merge_px);
     return CLAMP(t, 0.0f, 1.0f);
 }
 
+Vector2 QuadtreeCPU::get_morph_distances(const Ref<CameraParams>& cam) const {
+    ERR_FAIL_COND_V(cam.is_null(), Vector2());
+    // Mêmes seuils que compute_morph_factor : s_px = f * taille / d
+    const float focal_px = focal_length_px((float)cam->get_fov_y_deg(),
+                                           (float)cam->get_viewport_height_px());
+    const float split_px = target_error_px_;
+    const float merge_px = target_error_px_ * hysteresis_ratio_;
+    return Vector2(focal_px / split_px, focal_px / merge_px);
+}
+
 Array QuadtreeCPU::build_tile_list(const Ref<CameraParams>& cam) {
     Array out;
     if (cam.is_null()) return out;
@@ -130,12 +182,31 @@ Array QuadtreeCPU::build_tile_list(const Ref<CameraParams>& cam) {
     const float focal_px  = focal_length_px((float)cam->get_fov_y_deg(),
                                             (float)cam->get_viewport_height_px());
 
+    // Horizon culling seulement avec une position caméra dans le repère de l'Ellipsoid
+    Ellipsoid* ellipsoid = get_ellipsoid();
+    if (!ellipsoid && ellipsoid_id_.is_valid()) {
+        ellipsoid_id_ = ObjectID(); // ellipsoïde libéré entre deux frames
+        occluder_cache_.clear();
+    }
+    if (ellipsoid && ellipsoid->get_axis() != occluder_axis_) {
+        occluder_cache_.clear(); // set_axis (ex. SCALED_WGS84 -> WGS84) : occulteurs périmés
+        occluder_axis_ = ellipsoid->get_axis();
+    }
+    if (!cam->has_globe_position()) ellipsoid = nullptr;
+    const Vector3 globe_cam_pos = cam->get_globe_position();
+
+    std::vector<Tile> leaves;
     std::queue<QuadTreeNode> q;
     q.push({0,0,0,1.0f, Vector2(0.5f,0.5f)});
 
     while (!q.empty()) {
         auto n = q.front(); q.pop();
 
+        // ---- HORIZON (avant tout calcul d'erreur) ----
+        if (ellipsoid && !is_above_horizon(ellipsoid, TileKey{n.lod, n.ix, n.iy}, globe_cam_pos)) {
+            continue; // face cachée du globe
+        }
+
         // ---- CULLING ICI (prune traversal) ----
         const float radius = n.size * 0.70710678f; // ~ size*sqrt(2)/2 à y≈0
         const Vector3 center3(n.center.x, 0.0f, n.center.y);
@@ -167,14 +238,129 @@ Array QuadtreeCPU::build_tile_list(const Ref<CameraParams>& cam) {
                 });
             }
         } else {
-            Dictionary d;
-            d["lod"]   = n.lod;
-            d["ix"]    = n.ix;
-            d["iy"]    = n.iy;
-            d["morph"] = compute_morph_factor(n.lod, cam_pos, focal_px, n.center, n.size);
-            out.push_back(d);
+            Tile t;
+            t.lod   = n.lod;
+            t.ix    = n.ix;
+            t.iy    = n.iy;
+            t.morph = compute_morph_factor(n.lod, cam_pos, focal_px, n.center, n.size);
+            leaves.push_back(t);
+        }
+    }
+
+    // ---- Équilibrage 2:1 : les variantes cousues ne gèrent qu'un écart d'un LOD ----
+    HashSet<TileKey, KeyHash, KeyEq> leaf_set;
+    HashMap<TileKey, int, KeyHash, KeyEq> leaf_index; // feuille -> indice dans leaves
+    for (size_t i = 0; i < leaves.size(); ++i) {
+        const TileKey k{leaves[i].lod, leaves[i].ix, leaves[i].iy};
+        leaf_set.insert(k);
+        leaf_index.insert(k, int(i));
+    }
+
+    static const int dirs4[4][2] = { { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } };
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 0; i < leaves.size(); ++i) {
+            const Tile t = leaves[i];
+            if (t.lod < 0) continue; // feuille redécoupée
+            const int side = 1 << t.lod;
+            for (const auto& d : dirs4) {
+                const int nx = t.ix + d[0];
+                const int ny = t.iy + d[1];
+                if (nx < 0 || ny < 0 || nx >= side || ny >= side) continue;
+                // voisin couvert par une feuille plus grossière de 2 LOD ou plus : on la découpe
+                for (int up = 2; up <= t.lod; ++up) {
+                    const TileKey coarse{t.lod - up, nx >> up, ny >> up};
+                    const int* coarse_index = leaf_index.getptr(coarse);
+                    if (!coarse_index) continue;
+                    leaves[*coarse_index].lod = -1;
+                    leaf_set.erase(coarse);
+                    leaf_index.erase(coarse);
+                    const float hs = 1.0f / float(1 << (coarse.lod + 1));
+                    for (int dy = 0; dy < 2; ++dy) for (int dx = 0; dx < 2; ++dx) {
+                        Tile c;
+                        c.lod = coarse.lod + 1;
+                        c.ix  = (coarse.ix << 1) | dx;
+                        c.iy  = (coarse.iy << 1) | dy;
+                        const TileKey child{c.lod, c.ix, c.iy};
+                        const Vector2 center((c.ix + 0.5f) * hs, (c.iy + 0.5f) * hs);
+                        // mêmes tests que pendant la descente : pas de tuile cachée ni hors champ
+                        if (ellipsoid && !is_above_horizon(ellipsoid, child, globe_cam_pos)) continue;
+                        if (!approx_visible_planar(cam_pos, cam_fwd, fov_y, aspect, near_d, far_d,
+                                                   Vector3(center.x, 0.0f, center.y), hs * 0.70710678f)) continue;
+                        c.morph = compute_morph_factor(c.lod, cam_pos, focal_px, center, hs);
+                        leaf_set.insert(child);
+                        leaf_index.insert(child, int(leaves.size()));
+                        leaves.push_back(c);
+                    }
+                    changed = true;
+                    break;
+                }
+            }
         }
     }
 
+    // ---- Masque de voisinage (SharedGrid::get_or_create_stitched_grid) ----
+    for (const Tile& t : leaves) {
+        if (t.lod < 0) continue;
+        Dictionary d;
+        d["lod"]       = t.lod;
+        d["ix"]        = t.ix;
+        d["iy"]        = t.iy;
+        d["morph"]     = t.morph;
+        d["edge_mask"] = compute_edge_mask(leaf_set, t);
+        d["finer_mask"] = compute_finer_mask(leaf_set, t);
+        out.push_back(d);
+    }
+
     return out;
-}
\ No newline at end of file
+}
+
+int QuadtreeCPU::compute_edge_mask(const HashSet<TileKey, KeyHash, KeyEq>& leaves, const Tile& t) {
+    // bit posé si le voisin est couvert par une feuille plus grossière (écart d'un LOD au plus,
+    // garanti par l'équilibrage 2:1 de build_tile_list)
+    static const int dirs[4][3] = {
+        { 0, -1, 1 }, // nord  (EDGE_NORTH)
+        { +1, 0, 2 }, // est   (EDGE_EAST)
+        { 0, +1, 4 }, // sud   (EDGE_SOUTH)
+        { -1, 0, 8 }, // ouest (EDGE_WEST)
+    };
+    const int side = 1 << t.lod;
+    int mask = 0;
+    for (const auto& d : dirs) {
+        const int nx = t.ix + d[0];
+        const int ny = t.iy + d[1];
+        if (nx < 0 || ny < 0 || nx >= side || ny >= side) continue;
+        for (int up = 1; up <= t.lod; ++up) {
+            if (leaves.has(TileKey{t.lod - up, nx >> up, ny >> up})) {
+                mask |= d[2];
+                break;
+            }
+        }
+    }
+    return mask;
+}
+int QuadtreeCPU::compute_finer_mask(const HashSet<TileKey, KeyHash, KeyEq>& leaves, const Tile& t) {
+    // bit posé si le voisin de même LOD est redécoupé : le shader garde ce bord à pleine
+    // résolution (morph = 1), c'est-à-dire là où se pose le bord cousu du voisin
+    static const int dirs[4][3] = {
+        { 0, -1, 1 }, // nord  (EDGE_NORTH)
+        { +1, 0, 2 }, // est   (EDGE_EAST)
+        { 0, +1, 4 }, // sud   (EDGE_SOUTH)
+        { -1, 0, 8 }, // ouest (EDGE_WEST)
+    };
+    const int side = 1 << t.lod;
+    int mask = 0;
+    for (const auto& d : dirs) {
+        const int nx = t.ix + d[0];
+        const int ny = t.iy + d[1];
+        if (nx < 0 || ny < 0 || nx >= side || ny >= side) continue;
+        if (leaves.has(TileKey{t.lod, nx, ny})) continue;
+        bool coarser = false;
+        for (int up = 1; up <= t.lod && !coarser; ++up) {
+            coarser = leaves.has(TileKey{t.lod - up, nx >> up, ny >> up});
+        }
+        if (!coarser) mask |= d[2]; // redécoupé (ou hors champ, sans effet visible)
+    }
+    return mask;
+}
@@ -1,11 +1,14 @@
 #pragma once
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/object_id.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
 #include <vector>
 
 #include "camera_params.hpp"
+#include "math/Ellipsoid.hpp"
 
 namespace godot {
 
@@ -38,14 +41,48 @@ public:
     void set_max_lod(int max_lod);
     void set_screen_error_px(float px);
 
+    // Horizon culling : si un Ellipsoid est fourni, le carré [0..1]² est lu comme une grille
+    // équirectangulaire (u -> lon -180..180, v -> lat 90..-90). Le test utilise
+    // CameraParams.globe_position (repère local de l'Ellipsoid) ; position reste la caméra
+    // au-dessus du plan [0..1]² pour l'erreur écran et le frustum. Sans globe_position,
+    // pas d'horizon culling.
+    void set_ellipsoid(Ellipsoid* ellipsoid);
+    void set_max_terrain_height(float h);
+
     // Construit la liste visible (simple: frustum ignoré dans ce squelette)
+    // Chaque entrée : lod, ix, iy, morph (au centre de la tuile, indicatif : les shaders le
+    // recalculent par sommet), edge_mask (voisins plus grossiers) et finer_mask
+    // (voisins plus fins), tous deux en bits SharedGrid::Edge
     Array build_tile_list(const Ref<CameraParams>& cam);
 
+    // Géomorphing par sommet (CDLOD) : distances caméra de découpe (x) et de fusion (y) pour
+    // une tuile de taille 1, à multiplier par la taille de la tuile. Le shader en tire morph
+    // depuis la distance du sommet, continue d'une tuile à l'autre (uniform morph_distances).
+    Vector2 get_morph_distances(const Ref<CameraParams>& cam) const;
+
 private:
     float hysteresis_ratio_ = 0.75f;
     float target_error_px_ = 64.0f;
     int max_lod_ = 7;
 
+    // ObjectID plutôt qu'un pointeur : l'Ellipsoid (Node) peut être libéré avant le quadtree
+    ObjectID ellipsoid_id_;
+    float max_terrain_height_ = 0.0f;
+    // Points occulteurs (espace normalisé) par tuile, statiques tant que l'ellipsoïde ne change pas
+    godot::HashMap<TileKey, Vector3, KeyHash, KeyEq> occluder_cache_;
+    Vector3 occluder_axis_; // axes de l'ellipsoïde avec lesquels le cache a été rempli
+
+    Ellipsoid* get_ellipsoid() const;
+    bool is_above_horizon(Ellipsoid* ellipsoid, const TileKey& key, const Vector3& globe_cam_pos);
+
+    static int compute_edge_mask(
+        const godot::HashSet<TileKey, KeyHash, KeyEq>& leaves,
+        const Tile& tile
+    );
+    static int compute_finer_mask(
+        const godot::HashSet<TileKey, KeyHash, KeyEq>& leaves,
+        const Tile& tile
+    );
 
     godot::HashMap<TileKey, bool, KeyHash, KeyEq> hot_split_;
         bool decide_split_with_hysteresis(
@@ -1,64 +1,247 @@
 #include "shared_grid.hpp"
+#include "mesh/VertexCacheOptimizer.hpp"
 
 #include <godot_cpp/classes/surface_tool.hpp>
 #include <godot_cpp/classes/array_mesh.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
+#include <cstring>
+#include <vector>
+
 using namespace godot;
 
 void SharedGrid::_bind_methods() {
-    ClassDB::bind_method(D_METHOD("get_or_create_grid", "resolution"), &SharedGrid::get_or_create_grid);
+    ClassDB::bind_method(D_METHOD("get_or_create_grid", "resolution", "format"), &SharedGrid::get_or_create_grid, DEFVAL(65), DEFVAL(FORMAT_FULL));
+    ClassDB::bind_method(D_METHOD("get_or_create_stitched_grid", "edge_mask", "skirts", "resolution", "format"), &SharedGrid::get_or_create_stitched_grid, DEFVAL(false), DEFVAL(65), DEFVAL(FORMAT_FULL));
+    ClassDB::bind_method(D_METHOD("clear_cache"), &SharedGrid::clear_cache);
+    ClassDB::bind_method(D_METHOD("get_cached_grid_count"), &SharedGrid::get_cached_grid_count);
+    ClassDB::bind_method(D_METHOD("set_optimize_vertex_cache", "enable"), &SharedGrid::set_optimize_vertex_cache);
+    ClassDB::bind_method(D_METHOD("get_optimize_vertex_cache"), &SharedGrid::get_optimize_vertex_cache);
+
+    BIND_ENUM_CONSTANT(EDGE_NORTH);
+    BIND_ENUM_CONSTANT(EDGE_EAST);
+    BIND_ENUM_CONSTANT(EDGE_SOUTH);
+    BIND_ENUM_CONSTANT(EDGE_WEST);
+
+    BIND_ENUM_CONSTANT(FORMAT_FULL);
+    BIND_ENUM_CONSTANT(FORMAT_POSITION_2D);
+}
+
+uint64_t SharedGrid::make_key(int resolution, VertexFormat format, int edge_mask, bool skirts) {
+    return (uint64_t(uint32_t(resolution)) << 32) | (uint64_t(format) << 8) |
+           (uint64_t(skirts ? 1 : 0) << 4) | uint64_t(edge_mask & 15);
+}
+
+Ref<ArrayMesh> SharedGrid::get_or_create_grid(int resolution, VertexFormat format) {
+    return get_or_create_stitched_grid(0, false, resolution, format);
+}
+
+Ref<ArrayMesh> SharedGrid::get_or_create_stitched_grid(int edge_mask, bool skirts, int resolution, VertexFormat format) {
+    ERR_FAIL_COND_V(edge_mask < 0 || edge_mask > 15, Ref<ArrayMesh>());
+    ERR_FAIL_COND_V(resolution < 2, Ref<ArrayMesh>());
+
+    const uint64_t key = make_key(resolution, format, edge_mask, skirts);
+    if (const Ref<ArrayMesh>* cached = cache_.getptr(key)) return *cached;
+
+    Ref<ArrayMesh> mesh = build_grid(resolution, format, edge_mask, skirts);
+    if (mesh.is_valid()) cache_.insert(key, mesh);
+    return mesh;
+}
+
+void SharedGrid::clear_cache() {
+    cache_.clear();
+}
+
+int SharedGrid::get_cached_grid_count() const {
+    return (int)cache_.size();
 }
 
-Ref<ArrayMesh> SharedGrid::get_or_create_grid(int resolution) {
-    if (grid_.is_valid()) return grid_;
+void SharedGrid::set_optimize_vertex_cache(bool enable) {
+    if (optimize_vertex_cache_ == enable) return;
+    optimize_vertex_cache_ = enable;
+    cache_.clear();
+}
 
-    // Grille en [0..1]x[0..1], Z=0 (hauteur ajoutée ailleurs)
-    PackedVector3Array verts;
-    PackedVector3Array norms;
-    PackedVector2Array uvs;
-    PackedInt32Array  indices;
+// float -> half IEEE 754 (arrondi au plus proche, suffisant pour des offsets de grille)
+static inline uint16_t to_half(float f) {
+    uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    const uint32_t sign = (x >> 16) & 0x8000u;
+    const int32_t  exp  = int32_t((x >> 23) & 0xffu) - 127 + 15;
+    uint32_t mant = x & 0x7fffffu;
+    if (exp <= 0) {
+        if (exp < -10) return uint16_t(sign);
+        mant |= 0x800000u;
+        const uint32_t shift = uint32_t(14 - exp);
+        return uint16_t(sign | ((mant + (1u << (shift - 1))) >> shift));
+    }
+    if (exp >= 31) return uint16_t(sign | 0x7c00u);
+    return uint16_t(sign | ((uint32_t(exp) << 10) + ((mant + 0x1000u) >> 13)));
+}
+
+// Sommet de bord cousu : les indices impairs le long d'un bord au voisin plus grossier
+// se replient sur le sommet pair précédent (même convention que le géomorphing).
+static inline int stitch_remap(int x, int y, int N, int edge_mask) {
+    if ((edge_mask & SharedGrid::EDGE_NORTH) && y == 0     && (x & 1)) x -= 1;
+    if ((edge_mask & SharedGrid::EDGE_SOUTH) && y == N - 1 && (x & 1)) x -= 1;
+    if ((edge_mask & SharedGrid::EDGE_WEST)  && x == 0     && (y & 1)) y -= 1;
+    if ((edge_mask & SharedGrid::EDGE_EAST)  && x == N - 1 && (y & 1)) y -= 1;
+    return y * N + x;
+}
 
+static inline void push_triangle(PackedInt32Array& indices, int a, int b, int c) {
+    if (a == b || b == c || a == c) return; // triangle dégénéré par la couture
+    indices.push_back(a); indices.push_back(b); indices.push_back(c);
+}
+
+Ref<ArrayMesh> SharedGrid::build_grid(int resolution, VertexFormat format, int edge_mask, bool skirts) const {
     const int N = resolution;
-    verts.resize(N * N);
-    norms.resize(N * N);
-    uvs.resize(N * N);
+    ERR_FAIL_COND_V(N < 2, Ref<ArrayMesh>());
+
+    // Géomorphing et couture demandent un nombre pair de segments
+    const bool can_morph = ((N - 1) % 2) == 0;
+    if (!can_morph) edge_mask = 0;
+
+    // Périmètre (sens horaire depuis le coin nord-ouest) pour les jupes
+    std::vector<int> perimeter;
+    if (skirts) {
+        perimeter.reserve(4 * (N - 1));
+        for (int x = 0; x < N - 1; ++x) perimeter.push_back(x);                       // nord
+        for (int y = 0; y < N - 1; ++y) perimeter.push_back(y * N + (N - 1));         // est
+        for (int x = N - 1; x > 0; --x) perimeter.push_back((N - 1) * N + x);         // sud
+        for (int y = N - 1; y > 0; --y) perimeter.push_back(y * N);                   // ouest
+    }
+    const int grid_count = N * N;
+    const int vert_count = grid_count + (int)perimeter.size();
+
+    // Le RenderingServer passe en indices 16 bits tant que le maillage a au plus 65536 sommets
+    if (vert_count > 65536) {
+        WARN_PRINT("SharedGrid: more than 65536 vertices, index buffer falls back to 32 bits.");
+    }
+
+    // Géomorphing façon CDLOD : les sommets d'indice impair glissent vers le sommet pair
+    // précédent, ce qui reproduit exactement la grille du LOD parent quand le décalage est appliqué.
+    // Le shader fait : uv = VERTEX.xz + CUSTOM0.xy * (1 - morph)  (morph = 1 : pleine résolution).
+    const float step = 1.0f / float(N - 1);
+    std::vector<float> morph_uv((size_t)vert_count * 2);
+    std::vector<Vector2> grid_uv((size_t)vert_count);
+    std::vector<uint8_t> is_skirt((size_t)vert_count, 0);
 
     int i = 0;
     for (int y = 0; y < N; ++y) {
         for (int x = 0; x < N; ++x) {
-            const float fx = x / float(N - 1);
-            const float fy = y / float(N - 1);
-            verts[i] = Vector3(fx, 0.0f, fy);   // (u, 0, v)
-            norms[i] = Vector3(0, 1, 0);
-            uvs[i]   = Vector2(fx, fy);
+            grid_uv[i] = Vector2(x * step, y * step);
+            morph_uv[i * 2 + 0] = (can_morph && (x & 1)) ? -step : 0.0f;
+            morph_uv[i * 2 + 1] = (can_morph && (y & 1)) ? -step : 0.0f;
             ++i;
         }
     }
+    // Jupes : copie des sommets du bord, abaissés par le shader
+    for (int s = 0; s < (int)perimeter.size(); ++s, ++i) {
+        const int src = perimeter[s];
+        grid_uv[i] = grid_uv[src];
+        morph_uv[i * 2 + 0] = morph_uv[src * 2 + 0];
+        morph_uv[i * 2 + 1] = morph_uv[src * 2 + 1];
+        is_skirt[i] = 1;
+    }
 
     // triangles
+    PackedInt32Array indices;
     for (int y = 0; y < N - 1; ++y) {
         for (int x = 0; x < N - 1; ++x) {
-            const int i0 =  y      * N + x;
-            const int i1 =  y      * N + (x + 1);
-            const int i2 = (y + 1) * N + x;
-            const int i3 = (y + 1) * N + (x + 1);
+            const int i0 = stitch_remap(x,     y,     N, edge_mask);
+            const int i1 = stitch_remap(x + 1, y,     N, edge_mask);
+            const int i2 = stitch_remap(x,     y + 1, N, edge_mask);
+            const int i3 = stitch_remap(x + 1, y + 1, N, edge_mask);
             // tri 1
-            indices.push_back(i0); indices.push_back(i2); indices.push_back(i1);
+            push_triangle(indices, i0, i2, i1);
             // tri 2
-            indices.push_back(i1); indices.push_back(i2); indices.push_back(i3);
+            push_triangle(indices, i1, i2, i3);
         }
     }
 
+    if (skirts) {
+        // Un quad de jupe par segment du bord ; sur un bord cousu on saute les sommets repliés
+        const int P = (int)perimeter.size();
+        std::vector<int> skirt_of(grid_count, -1);
+        for (int s = 0; s < P; ++s) skirt_of[perimeter[s]] = grid_count + s;
+
+        for (int s = 0; s < P; ++s) {
+            const int a = perimeter[s];
+            const int b = perimeter[(s + 1) % P];
+            const int ra = stitch_remap(a % N, a / N, N, edge_mask);
+            const int rb = stitch_remap(b % N, b / N, N, edge_mask);
+            if (ra == rb) continue;
+            const int sa = skirt_of[ra];
+            const int sb = skirt_of[rb];
+            push_triangle(indices, ra, rb, sa);
+            push_triangle(indices, rb, sb, sa);
+        }
+    }
+
+    if (optimize_vertex_cache_) {
+        const float acmr_before = VertexCacheOptimizer::acmr(indices.ptr(), indices.size(), vert_count);
+        VertexCacheOptimizer::optimize(indices.ptrw(), indices.size(), vert_count);
+        const float acmr_after = VertexCacheOptimizer::acmr(indices.ptr(), indices.size(), vert_count);
+        UtilityFunctions::print_verbose("SharedGrid ", N, "x", N, " mask ", edge_mask, ": ACMR ", acmr_before, " -> ", acmr_after);
+    }
+
     Array arrays;
     arrays.resize(Mesh::ARRAY_MAX);
-    arrays[Mesh::ARRAY_VERTEX] = verts;
-    arrays[Mesh::ARRAY_NORMAL] = norms;
-    arrays[Mesh::ARRAY_TEX_UV] = uvs;
-    arrays[Mesh::ARRAY_INDEX]  = indices;
+    uint64_t flags = 0;
+
+    if (format == FORMAT_POSITION_2D) {
+        // Position (u, v) seule + CUSTOM0 en demi-flottants : (morph.x, morph.y, jupe, 0)
+        PackedVector2Array verts;
+        PackedByteArray custom;
+        verts.resize(vert_count);
+        custom.resize(vert_count * 4 * sizeof(uint16_t));
+        Vector2* v = verts.ptrw();
+        uint16_t* c = reinterpret_cast<uint16_t*>(custom.ptrw());
+        for (int k = 0; k < vert_count; ++k) {
+            v[k] = grid_uv[k];
+            c[k * 4 + 0] = to_half(morph_uv[k * 2 + 0]);
+            c[k * 4 + 1] = to_half(morph_uv[k * 2 + 1]);
+            c[k * 4 + 2] = to_half(is_skirt[k] ? -1.0f : 0.0f);
+            c[k * 4 + 3] = 0;
+        }
+        arrays[Mesh::ARRAY_VERTEX]  = verts;
+        arrays[Mesh::ARRAY_CUSTOM0] = custom;
+        flags = Mesh::ARRAY_FLAG_USE_2D_VERTICES |
+                (uint64_t(Mesh::ARRAY_CUSTOM_RGBA_HALF) << Mesh::ARRAY_FORMAT_CUSTOM0_SHIFT);
+    } else {
+        // Grille en [0..1]x[0..1], Y=0 (hauteur ajoutée ailleurs), jupes en Y=-1
+        PackedVector3Array verts;
+        PackedVector3Array norms;
+        PackedVector2Array uvs;
+        PackedFloat32Array morph;   // CUSTOM0 (RG) : décalage vers la grille parente
+        verts.resize(vert_count);
+        norms.resize(vert_count);
+        uvs.resize(vert_count);
+        morph.resize(vert_count * 2);
+        Vector3* v = verts.ptrw();
+        Vector3* nr = norms.ptrw();
+        Vector2* t = uvs.ptrw();
+        float* m = morph.ptrw();
+        for (int k = 0; k < vert_count; ++k) {
+            v[k]  = Vector3(grid_uv[k].x, is_skirt[k] ? -1.0f : 0.0f, grid_uv[k].y);   // (u, 0, v)
+            nr[k] = Vector3(0, 1, 0);
+            t[k]  = grid_uv[k];
+            m[k * 2 + 0] = morph_uv[k * 2 + 0];
+            m[k * 2 + 1] = morph_uv[k * 2 + 1];
+        }
+        arrays[Mesh::ARRAY_VERTEX]  = verts;
+        arrays[Mesh::ARRAY_NORMAL]  = norms;
+        arrays[Mesh::ARRAY_TEX_UV]  = uvs;
+        arrays[Mesh::ARRAY_CUSTOM0] = morph;
+        flags = uint64_t(Mesh::ARRAY_CUSTOM_RG_FLOAT) << Mesh::ARRAY_FORMAT_CUSTOM0_SHIFT;
+    }
+    arrays[Mesh::ARRAY_INDEX] = indices;
 
     Ref<ArrayMesh> mesh = memnew(ArrayMesh);
-    mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
-    grid_ = mesh;
-    return grid_;
+    mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays, TypedArray<Array>(), Dictionary(), flags);
+    return mesh;
 }
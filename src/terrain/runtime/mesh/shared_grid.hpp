@@ -2,6 +2,7 @@
 #include <godot_cpp/classes/array_mesh.hpp>
 #include <godot_cpp/classes/ref.hpp>
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
 
 namespace godot {
 
@@ -9,12 +10,51 @@ class SharedGrid : public Object {
     GDCLASS(SharedGrid, Object);
 
 public:
+    // Bits du masque de voisinage : bord dont le voisin est au LOD parent (v = 0 au nord)
+    enum Edge {
+        EDGE_NORTH = 1,
+        EDGE_EAST  = 2,
+        EDGE_SOUTH = 4,
+        EDGE_WEST  = 8,
+    };
+
+    // Format des sommets
+    // - FORMAT_FULL        : VERTEX (u, 0|-1, v) + NORMAL + UV + CUSTOM0 RG_FLOAT (morph)  ~32 o/sommet
+    // - FORMAT_POSITION_2D : VERTEX (u, v) 2D + CUSTOM0 RGBA_HALF (morph.xy, jupe.z)   16 o/sommet
+    //   (la hauteur vient des textures, UV = VERTEX.xy)
+    enum VertexFormat {
+        FORMAT_FULL        = 0,
+        FORMAT_POSITION_2D = 1,
+    };
+
     static void _bind_methods();
 
-    Ref<ArrayMesh> get_or_create_grid(int resolution = 65);
+    Ref<ArrayMesh> get_or_create_grid(int resolution = 65, VertexFormat format = FORMAT_FULL);
+
+    // Variante pré-calculée par masque (16 configurations) + jupes optionnelles.
+    // Les bords cousus ne gardent qu'un sommet sur deux (triangles en éventail),
+    // les jupes ont VERTEX.y = -1 (le shader les abaisse de skirt_depth).
+    Ref<ArrayMesh> get_or_create_stitched_grid(int edge_mask, bool skirts = false,
+                                               int resolution = 65, VertexFormat format = FORMAT_FULL);
+
+    void clear_cache();
+    int get_cached_grid_count() const;
+
+    // Réordonne les triangles pour le cache de sommets GPU (VertexCacheOptimizer), actif par défaut
+    void set_optimize_vertex_cache(bool enable);
+    bool get_optimize_vertex_cache() const { return optimize_vertex_cache_; }
 
 private:
-    Ref<ArrayMesh> grid_;
+    bool optimize_vertex_cache_ = true;
+
+    // clé : résolution | format | masque | jupes
+    HashMap<uint64_t, Ref<ArrayMesh>> cache_;
+
+    static uint64_t make_key(int resolution, VertexFormat format, int edge_mask, bool skirts);
+    Ref<ArrayMesh> build_grid(int resolution, VertexFormat format, int edge_mask, bool skirts) const;
 };
 
-} // namespace godot
\ No newline at end of file
+} // namespace godot
+
+VARIANT_ENUM_CAST(godot::SharedGrid::Edge);
+VARIANT_ENUM_CAST(godot::SharedGrid::VertexFormat);